@@ -43,6 +43,7 @@ typedef struct FT_FaceRec_*  FT_Face;
 namespace cinder { namespace gl {
 
 class SdfText;
+class SdfTextBox;
 using SdfTextRef = std::shared_ptr<SdfText>;
 
 //! \class SdfText
@@ -87,6 +88,63 @@ public:
 		Format&			sdfTileSpacing( const ivec2& value ) { mSdfTileSpacing = value; return *this; }
 		const ivec2&	getSdfTileSpacing() const { return mSdfTileSpacing; }
 
+		//! Enables packing the glyphs into atlas pages shared with other SdfText instances whose formats have the same texture size, tile spacing, sdfScale, sdfRange, distanceTransform and singleChannel, instead of pages of their own. Saves textures and texture binds when many fonts hold few glyphs. Default \c false
+		Format&			sharedPages( bool enable = true ) { mSharedPages = enable; return *this; }
+		//! Returns whether the glyphs are packed into atlas pages shared with other SdfText instances. Default \c false
+		bool			isSharedPages() const { return mSharedPages; }
+
+		//! Enables generating glyphs on demand. Characters missing from the atlas are looked up in the font when text is laid out, and their glyphs are generated and uploaded in a batch by the next draw. Once the pages reach the dynamicBudget the least recently drawn glyphs are evicted and the rest are repacked, so placements from placeChars, such as in SdfTextMesh, don't stay valid. Dynamic atlases don't share pages. Default \c false
+		Format&			dynamic( bool enable = true ) { mDynamic = enable; return *this; }
+		//! Returns whether glyphs are generated on demand. Default \c false
+		bool			isDynamic() const { return mDynamic; }
+		//! Sets the memory, in bytes, the pages of a dynamic atlas may take before glyphs are evicted. At least one page is kept. Default \c 16 MB
+		Format&			dynamicBudget( size_t bytes ) { mDynamicBudget = bytes; return *this; }
+		//! Returns the memory, in bytes, the pages of a dynamic atlas may take before glyphs are evicted. Default \c 16 MB
+		size_t			getDynamicBudget() const { return mDynamicBudget; }
+
+		//! Sets the number of threads used to generate the glyph atlases. \c 0 uses one thread per hardware thread. Default \c 0
+		Format&			threadCount( uint32_t value ) { mThreadCount = value; return *this; }
+		//! Returns the number of threads used to generate the glyph atlases. \c 0 uses one thread per hardware thread. Default \c 0
+		uint32_t		getThreadCount() const { return mThreadCount; }
+
+		//! Enables computing distances in single precision, which is faster for fonts with cubic outlines. The median of the generated channels stays within one code value of double precision. Default \c false
+		Format&			singlePrecision( bool enable = true ) { mSinglePrecision = enable; return *this; }
+		//! Returns whether distances are computed in single precision. Default \c false
+		bool			isSinglePrecision() const { return mSinglePrecision; }
+
+		//! Sets the maximum error, in atlas texels, of approximating the cubic curves of glyph outlines (OTF/CFF fonts) with quadratic curves, which generate faster. \c 0 keeps the cubic curves. Default \c 0
+		Format&			cubicTolerance( float texels ) { mCubicTolerance = texels; return *this; }
+		//! Returns the maximum error, in atlas texels, of approximating cubic curves. Default \c 0
+		float			getCubicTolerance() const { return mCubicTolerance; }
+		//! Approximates cubic curves with line segments instead of quadratic curves, requires a cubicTolerance. Default \c false
+		Format&			cubicsToLines( bool enable = true ) { mCubicsToLines = enable; return *this; }
+		//! Returns whether cubic curves are approximated with line segments. Default \c false
+		bool			isCubicsToLines() const { return mCubicsToLines; }
+		//! Sets the maximum change, in atlas texels, of simplifying glyph outlines before generating, which removes zero-length edges, replaces nearly flat curves with line segments and merges nearly collinear line segments. \c 0 keeps the outlines. Default \c 0
+		Format&			simplifyTolerance( float texels ) { mSimplifyTolerance = texels; return *this; }
+		//! Returns the maximum change, in atlas texels, of simplifying glyph outlines. Default \c 0
+		float			getSimplifyTolerance() const { return mSimplifyTolerance; }
+		//! Enables computing exact distances only for texels within half the sdfRange of the outline, the others are set to fully inside or outside. Removes stray channel values far from the glyph. Default \c false
+		Format&			bandLimited( bool enable = true ) { mBandLimited = enable; return *this; }
+		//! Returns whether exact distances are only computed near the outline. Default \c false
+		bool			isBandLimited() const { return mBandLimited; }
+		//! Enables skipping blocks of texels that are provably farther than half the sdfRange from the outline, found by recursive subdivision of each glyph. Much faster for large glyphs. Single-channel fields are unchanged, pseudo-distance and multi-channel texels far from the outline saturate. Only whole blocks are skipped, so the texels aren't the same as with bandLimited. Default \c false
+		Format&			adaptive( bool enable = true ) { mAdaptive = enable; return *this; }
+		//! Returns whether blocks of texels far from the outline are skipped. Default \c false
+		bool			isAdaptive() const { return mAdaptive; }
+		//! Enables generating a single-channel distance field by a Euclidean distance transform, whose cost does not grow with the number of edges. Much faster for complex glyphs such as CJK, corners are rounded. Default \c false
+		Format&			distanceTransform( bool enable = true ) { mDistanceTransform = enable; return *this; }
+		//! Returns whether a single-channel distance field is generated by a distance transform. Default \c false
+		bool			isDistanceTransform() const { return mDistanceTransform; }
+		//! Together with distanceTransform, computes the exact pseudo-distance of every texel instead, which is slower but sharper at corners. Default \c false
+		Format&			maxQuality( bool enable = true ) { mMaxQuality = enable; return *this; }
+		//! Returns whether single-channel distance fields are computed exactly. Default \c false
+		bool			isMaxQuality() const { return mMaxQuality; }
+		//! Enables generating a single-channel pseudo-distance field and storing the atlas pages as R8 textures, which take a third of the memory and bandwidth of the three-channel field. Corners are rounded when glyphs are drawn much larger than they're generated, so it suits body text. Together with distanceTransform the field is generated by the distance transform instead. Drawn with defaultShader( true ), which drawString picks by itself. Default \c false
+		Format&			singleChannel( bool enable = true ) { mSingleChannel = enable; return *this; }
+		//! Returns whether the atlas pages hold a single-channel field. Default \c false
+		bool			isSingleChannel() const { return mSingleChannel; }
+
 	private:
 		ivec2			mTextureSize = ivec2( 1024 );
 		vec2			mSdfScale = vec2( 2.0f );
@@ -94,6 +152,19 @@ public:
 		float			mSdfRange = 4.0f;
 		float			mSdfAngle = 3.0f;
 		ivec2			mSdfTileSpacing = ivec2( 1 );
+		bool			mSharedPages = false;
+		bool			mDynamic = false;
+		size_t			mDynamicBudget = 16 * 1024 * 1024;
+		uint32_t		mThreadCount = 0;
+		bool			mSinglePrecision = false;
+		float			mCubicTolerance = 0.0f;
+		bool			mCubicsToLines = false;
+		float			mSimplifyTolerance = 0.0f;
+		bool			mBandLimited = false;
+		bool			mAdaptive = false;
+		bool			mDistanceTransform = false;
+		bool			mMaxQuality = false;
+		bool			mSingleChannel = false;
 	};
 
 	// ---------------------------------------------------------------------------------------------
@@ -196,6 +267,8 @@ public:
 			Area		mTexCoords;
 			vec2		mOriginOffset;
 			vec2		mSize;
+			//! Number of edges removed from the outline by Format::simplifyTolerance when the glyph was generated
+			uint32_t	mSimplifiedEdges;
 		};
 
 		using GlyphMetricsMap = std::map<SdfText::Font::Glyph, SdfText::Font::GlyphMetrics>;
@@ -255,18 +328,62 @@ public:
 
 	// ---------------------------------------------------------------------------------------------
 
+	//! \class AsyncHandle
+	//!
+	//! Tracks an SdfText whose glyphs createAsync is still generating in the background
+	class AsyncHandle {
+	public:
+		//! Returns the SdfText, which can be used right away. Glyphs that haven't been generated yet are left out when drawing
+		const SdfTextRef&	getSdfText() const { return mSdfText; }
+		//! Returns the fraction of the glyphs that are in the atlas, from \c 0 to \c 1
+		float				getProgress() const;
+		//! Returns whether all the glyphs are in the atlas, or the creation was canceled
+		bool				isDone() const;
+		//! Stops generating glyphs, the ones already in the atlas stay
+		void				cancel();
+		//! Returns whether the creation was canceled
+		bool				isCanceled() const;
+		//! Uploads the glyphs that were generated since the last call, which drawing the SdfText does as well. Must be called from the GL thread
+		void				update();
+
+	private:
+		AsyncHandle( const SdfTextRef &sdfText ) : mSdfText( sdfText ) {}
+
+		SdfTextRef			mSdfText;
+
+		friend class SdfText;
+	};
+
+	using AsyncHandleRef = std::shared_ptr<AsyncHandle>;
+
+	// ---------------------------------------------------------------------------------------------
+
 	virtual ~SdfText();
 
 	//! Creates a new SdfTextRef with font \a font, ensuring that glyphs necessary to render \a supportedChars are renderable, and format \a format
 	static SdfTextRef		create( const SdfText::Font &font, const Format &format = Format(), const std::string &utf8Chars = SdfText::defaultChars() );
 	//! Creates a new SdfTextRef with SDFT file at \a fontpath if it exists otherwise uses \a font and then saves SDFT file at \a filepath , ensuring that glyphs necessary to render \a supportedChars are renderable, and format \a format
 	static SdfTextRef		create( const fs::path& filePath, const SdfText::Font &font, const Format &format = Format(), const std::string &utf8Chars = SdfText::defaultChars() );
+	//! Creates a new SdfTextRef with font \a font and format \a format without waiting for all of \a utf8Chars to be generated. The glyphs for \a priorityChars are generated and uploaded before returning, the rest are generated on a background thread and uploaded in batches when the SdfText is drawn or AsyncHandle::update() is called. Layout works for all of \a utf8Chars right away
+	static AsyncHandleRef	createAsync( const SdfText::Font &font, const Format &format = Format(), const std::string &utf8Chars = SdfText::defaultChars(), const std::string &priorityChars = "" );
+
+	//! Sets the memory, in bytes, that parsed glyph outlines are cached up to. The cache is shared by all fonts, so that an outline is loaded once for measuring, rendering and metrics, and again only for later SdfText instances if it has been evicted. Default 32 MB
+	static void				setOutlineCacheBudget( size_t bytes );
+	//! Returns the memory, in bytes, that parsed glyph outlines are cached up to
+	static size_t			getOutlineCacheBudget();
 
 	static void				save( const DataTargetRef& target, const SdfTextRef& sdfText );
 	static void				save( const fs::path& filePath, const SdfTextRef& sdfText );
 	static SdfTextRef		load( const DataSourceRef& source, float size = 0 );
 	static SdfTextRef		load( const fs::path& filePath, float size = 0 );
 
+	//! Saves the glyph outlines, advances and metrics of \a sdfText to an outline pack, from which atlases with any Format can be generated by createFromOutlines without the font file. \a sdfText must have been created from a font rather than loaded from an SDFT file
+	static void				saveOutlines( const DataTargetRef& target, const SdfTextRef& sdfText );
+	static void				saveOutlines( const fs::path& filePath, const SdfTextRef& sdfText );
+	//! Creates a new SdfTextRef by generating the atlases for format \a format from the outline pack \a source, which was saved by saveOutlines. The font size is overridden by \a size if it's greater than 0
+	static SdfTextRef		createFromOutlines( const DataSourceRef& source, const Format &format = Format(), float size = 0 );
+	static SdfTextRef		createFromOutlines( const fs::path& filePath, const Format &format = Format(), float size = 0 );
+
 	//! Draws string \a str at baseline \a baseline with DrawOptions \a options
 	void	drawString( const std::string &str, const vec2 &baseline, const DrawOptions &options = DrawOptions() );
 	//! Draws string \a str fit inside \a fitRect vertically, with internal offset \a offset and DrawOptions \a options
@@ -319,12 +436,18 @@ public:
 
 	const SdfText::Font::GlyphMetricsMap&	getGlyphMetrics() const { return mGlyphMetrics; }
 	const SdfText::Font::CharToGlyphMap&	getCharToGlyph() const { return mCharToGlyph; }
+	//! Returns the number of edges removed from the outline of \a glyph by Format::simplifyTolerance, \c 0 if the atlas was loaded from an SDFT file
+	uint32_t								getSimplifiedEdges( SdfText::Font::Glyph glyph ) const;
+	//! Returns whether the textures hold a single-channel field, see Format::singleChannel
+	bool									isSingleChannel() const;
 
-	static gl::GlslProgRef	defaultShader();
+	//! Returns the default shader, sampling a single-channel field if \a singleChannel is set
+	static gl::GlslProgRef	defaultShader( bool singleChannel = false );
 
 private:
 	SdfText( const SdfText::Font &font, const Format &format, const std::string &utf8Chars, bool generateSdf = true );
 	friend class SdfTextManager;
+	friend class SdfTextBox;
 
 	class TextureAtlas;
 	using TextureAtlasRef = std::shared_ptr<TextureAtlas>;
@@ -332,9 +455,20 @@ private:
 	SdfText::Font						mFont;
 	Format								mFormat;
 	TextureAtlasRef						mTextureAtlases;
-	SdfText::Font::GlyphMetricsMap		mGlyphMetrics;
-	SdfText::Font::CharToGlyphMap		mCharToGlyph;
-	SdfText::Font::GlyphToCharMap		mGlyphToChar;
+	//! Dynamic formats add the characters they come across while laying out text
+	mutable SdfText::Font::GlyphMetricsMap	mGlyphMetrics;
+	mutable SdfText::Font::CharToGlyphMap	mCharToGlyph;
+	mutable SdfText::Font::GlyphToCharMap	mGlyphToChar;
+
+	//! Adds the characters of \a utf8Chars, and a space, to the char/glyph maps and returns their glyphs, each once
+	std::vector<SdfText::Font::Glyph>	mapChars( const std::string &utf8Chars );
+
+	//! Dynamic formats: adds the characters of \a utf8Chars that haven't been seen before and queues the glyphs missing from the atlas
+	void	requestChars( const std::string &utf8Chars ) const;
+	//! Dynamic formats: queues \a glyph if it's missing from the atlas
+	void	requestGlyph( SdfText::Font::Glyph glyph ) const;
+	//! Uploads the glyphs createAsync generated in the background. Dynamic formats also mark the glyphs in \a glyphMeasures as drawn, then generate and upload the queued glyphs
+	void	updateGlyphs( const SdfText::Font::GlyphMeasuresList &glyphMeasures );
 
 	Rectf	measureStringImpl( const std::string &str, bool wrapped, const Rectf &fitRect, const DrawOptions &options ) const;
 };
@@ -12,6 +12,39 @@ struct FloatRGB {
 	FloatRGB(float pr, float pg, float pb) : r(pr), g(pg), b(pb) {}
 };
 
+/// A view of an 8-bit image in memory owned by the caller, such as the cell of a glyph in a texture atlas.
+/// Generators write to it as they go, clamping each value to [0, 1] and scaling it by 255 (truncating),
+/// which saves a floating-point bitmap and the passes that convert it.
+struct ByteBitmapRef {
+    /// The first byte of the top-left pixel. Each pixel has one byte per channel of the distance field.
+    unsigned char *pixels;
+    int width, height;
+    /// Distances in bytes between horizontally and vertically adjacent pixels.
+    int pixelStride, rowStride;
+    /// If set, values are stored as 1-value, which swaps the inside and the outside of the shape.
+    bool invert;
+
+    ByteBitmapRef(unsigned char *pixels, int width, int height, int pixelStride, int rowStride, bool invert = false) :
+        pixels(pixels), width(width), height(height), pixelStride(pixelStride), rowStride(rowStride), invert(invert) { }
+};
+
+/// A read-only view of an 8-bit distance field in memory owned by the caller, such as the cell of a glyph in an atlas page.
+/// Each value is read as byte/255, the reverse of storing it through ByteBitmapRef.
+struct ByteBitmapConstRef {
+    /// The first byte of the top-left pixel.
+    const unsigned char *pixels;
+    int width, height;
+    /// The number of channels of the distance field, 1 or 3, stored in the first bytes of each pixel.
+    int channels;
+    /// Distances in bytes between horizontally and vertically adjacent pixels.
+    int pixelStride, rowStride;
+    /// If set, values are read as 1-value, as they were stored by an inverted ByteBitmapRef.
+    bool invert;
+
+    ByteBitmapConstRef(const unsigned char *pixels, int width, int height, int channels, int pixelStride, int rowStride, bool invert = false) :
+        pixels(pixels), width(width), height(height), channels(channels), pixelStride(pixelStride), rowStride(rowStride), invert(invert) { }
+};
+
 /// A 2D image bitmap.
 template <typename T>
 class Bitmap {
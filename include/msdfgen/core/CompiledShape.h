@@ -0,0 +1,102 @@
+
+#pragma once
+
+#include <vector>
+#include "Shape.h"
+
+namespace msdfgen {
+
+/// A line segment with the constants used by the distance computation precomputed.
+template <typename T>
+struct CompiledLinearSegmentT {
+    Vector2T<T> p[2];
+    Vector2T<T> ab, orthonormal, direction;
+    T abLengthSquared;
+
+    explicit CompiledLinearSegmentT(const Point2 *p);
+};
+
+/// A quadratic Bezier curve with the constants used by the distance computation precomputed.
+template <typename T>
+struct CompiledQuadraticSegmentT {
+    Vector2T<T> p[3];
+    Vector2T<T> ab, br, bc, ac, startDirection, endDirection;
+    /// The coefficients of the cubic equation that do not depend on the origin.
+    T a, b, c0;
+    T abLengthSquared, bcLengthSquared;
+
+    explicit CompiledQuadraticSegmentT(const Point2 *p);
+};
+
+/// A cubic Bezier curve with the constants used by the distance computation precomputed.
+template <typename T>
+struct CompiledCubicSegmentT {
+    Vector2T<T> p[4];
+    Vector2T<T> ab, bc, cd, startDirection, endDirection;
+    /// Scaled polynomial coefficients of the curve's derivatives.
+    Vector2T<T> ab3, br6, as3, as6;
+    T abLengthSquared, cdLengthSquared;
+
+    explicit CompiledCubicSegmentT(const Point2 *p);
+};
+
+/// A flattened representation of a shape, optimized for distance field generation.
+/// Segments are stored in contiguous arrays by type, so that distances can be computed without virtual calls.
+/// The precision of the distance computation is given by T - the constants are computed in double precision and rounded.
+/// The shape it was compiled from must not be modified or destroyed while the compiled shape is in use.
+template <typename T>
+class CompiledShapeT {
+
+public:
+    enum EdgeType {
+        LINEAR,
+        QUADRATIC,
+        CUBIC,
+        /// An edge segment of an unknown type, evaluated through its virtual methods.
+        OTHER
+    };
+
+    /// An edge of the shape and the data needed to convert its distance to pseudo-distance.
+    struct Edge {
+        EdgeType type;
+        /// Index into the array of segments of the edge's type.
+        int index;
+        EdgeColor color;
+        const EdgeSegment *source;
+        Vector2T<T> start, end;
+        Vector2T<T> startDirection, endDirection;
+        /// Bounds of the control polygon, which always contains the whole edge.
+        T l, b, r, t;
+    };
+
+    /// Number of points processed by signedDistanceBatch.
+    static const int BATCH_SIZE = sizeof(T) < sizeof(double) ? MSDFGEN_FLOAT_BATCH_SIZE : MSDFGEN_BATCH_SIZE;
+
+    /// All edges in the same order as in the original shape, which determines the result when distances are equal.
+    std::vector<Edge> edges;
+    std::vector<CompiledLinearSegmentT<T> > linearSegments;
+    std::vector<CompiledQuadraticSegmentT<T> > quadraticSegments;
+    std::vector<CompiledCubicSegmentT<T> > cubicSegments;
+    /// Indices of the edges that belong to the red, green, and blue channel respectively.
+    std::vector<int> channelEdges[3];
+    bool inverseYAxis;
+
+    explicit CompiledShapeT(const Shape &shape);
+    /// Computes the signed distance of an edge from BATCH_SIZE points, see EdgeSegment::signedDistanceBatch.
+    void signedDistanceBatch(const Edge &edge, const T *x, const T *y, SignedDistanceT<T> *distance, T *param) const;
+    /// Converts a signed distance from the edge to pseudo-distance, see EdgeSegment::distanceToPseudoDistance.
+    static void distanceToPseudoDistance(const Edge &edge, SignedDistanceT<T> &distance, Vector2T<T> origin, T param);
+    /// Finds the intersections of the outline with the horizontal line at y, see Shape::scanline.
+    void scanline(Scanline &line, double y) const;
+
+};
+
+typedef CompiledLinearSegmentT<double> CompiledLinearSegment;
+typedef CompiledQuadraticSegmentT<double> CompiledQuadraticSegment;
+typedef CompiledCubicSegmentT<double> CompiledCubicSegment;
+typedef CompiledShapeT<double> CompiledShape;
+/// A shape compiled for distance field generation in single precision. Quantized to 8 bits, the median of the output stays
+/// within one code value of double precision, individual channels may differ more where the sign of a distance is ambiguous.
+typedef CompiledShapeT<float> CompiledShapef;
+
+}
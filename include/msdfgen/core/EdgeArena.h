@@ -0,0 +1,58 @@
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace msdfgen {
+
+/// A memory region that edge segments are allocated from while it is active on the current thread, see EdgeArena::Scope.
+/// This covers every edge created by loading, copying, normalizing and coloring a shape, so that a shape can be built and destroyed
+/// without allocating on the heap once the arena has grown to fit it. Deleting such an edge does nothing, its memory is reclaimed
+/// by reset. Edges allocated elsewhere, or on threads without an active arena, come from the heap as before.
+/// Shapes whose edges are in an arena must be destroyed, or copied on a thread without an active arena, before the arena is reset.
+class EdgeArena {
+
+public:
+    /// Makes an arena the one edge segments are allocated from on the current thread, until the scope ends.
+    class Scope {
+
+    public:
+        explicit Scope(EdgeArena &arena);
+        ~Scope();
+
+    private:
+        EdgeArena *previous;
+
+        Scope(const Scope &);
+        Scope & operator=(const Scope &);
+
+    };
+
+    explicit EdgeArena(size_t blockSize = 65536);
+    ~EdgeArena();
+    /// Releases the memory of all segments allocated from the arena at once, and keeps it for the next ones.
+    void reset();
+    /// Returns the number of bytes reserved by the arena.
+    size_t capacity() const;
+
+    /// Returns memory for an object of the specified size, from the current thread's arena if there is one.
+    static void * allocate(size_t size);
+    /// Releases memory returned by allocate.
+    static void deallocate(void *ptr);
+
+private:
+    std::vector<char *> blocks;
+    std::vector<size_t> blockSizes;
+    size_t blockSize;
+    /// The block being allocated from and the position in it.
+    size_t block, offset;
+
+    void * allocateHere(size_t size);
+
+    EdgeArena(const EdgeArena &);
+    EdgeArena & operator=(const EdgeArena &);
+
+};
+
+}
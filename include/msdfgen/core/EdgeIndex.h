@@ -0,0 +1,50 @@
+
+#pragma once
+
+#include <vector>
+#include "arithmetics.hpp"
+#include "Vector2.h"
+#include "CompiledShape.h"
+
+namespace msdfgen {
+
+/// Divides the output of a distance field generator into square tiles and lists the edges of a shape
+/// that can possibly be the nearest edge to some pixel of each tile, preserving their original order.
+template <typename T>
+class EdgeIndexT {
+
+public:
+    typedef typename CompiledShapeT<T>::Edge Entry;
+
+    /// The width and height of a tile in pixels. A multiple of the batch sizes of both precisions, so that a batch of pixels never spans two tiles.
+    static const int TILE_SIZE = 8;
+
+    /// Builds the index for an output of the specified dimensions and transformation.
+    /// If multiChannel is set, edges are considered separately for the red, green and blue channels according to their color.
+    EdgeIndexT(const CompiledShapeT<T> &shape, int width, int height, const Vector2 &scale, const Vector2 &translate, bool multiChannel);
+    /// Retrieves the candidate edges for the tile that contains the pixel (x, y).
+    void tileEntries(int x, int y, const Entry * const *&begin, const Entry * const *&end) const;
+    /// Returns a lower bound of the distance between the outline and any pixel of the tile that contains the pixel (x, y).
+    double tileDistance(int x, int y) const {
+        return tileDistances[(y/TILE_SIZE)*tilesX+x/TILE_SIZE];
+    }
+    /// Returns true if the edge is farther than maxDistance from p, i.e. it does not need to be evaluated.
+    inline bool isFartherThan(const Entry &entry, Vector2T<T> p, T maxDistance) const {
+        T dx = max(max(entry.l-p.x, p.x-entry.r), T(0));
+        T dy = max(max(entry.b-p.y, p.y-entry.t), T(0));
+        T bound = maxDistance+tolerance;
+        return dx*dx+dy*dy > bound*bound;
+    }
+
+private:
+    std::vector<const Entry *> candidates;
+    std::vector<int> tileOffsets;
+    std::vector<double> tileDistances;
+    int tilesX;
+    T tolerance;
+
+};
+
+typedef EdgeIndexT<double> EdgeIndex;
+
+}
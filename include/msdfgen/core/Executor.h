@@ -0,0 +1,37 @@
+
+#pragma once
+
+namespace msdfgen {
+
+/// A job that consists of a number of independent parts.
+class ParallelTask {
+
+public:
+    virtual ~ParallelTask() { }
+    /// Processes the part with the specified index. Different parts may be processed concurrently.
+    virtual void run(int index) = 0;
+
+};
+
+/// Interface for running the parts of a task on a thread pool of the caller's choice.
+class Executor {
+
+public:
+    virtual ~Executor() { }
+    /// Runs task.run(i) for each i from 0 to count-1 and returns when all of them have finished.
+    virtual void execute(ParallelTask &task, int count) = 0;
+
+};
+
+/// Runs all parts of a task in order on the calling thread.
+class SerialExecutor : public Executor {
+
+public:
+    void execute(ParallelTask &task, int count) {
+        for (int i = 0; i < count; ++i)
+            task.run(i);
+    }
+
+};
+
+}
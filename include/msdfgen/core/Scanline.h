@@ -0,0 +1,37 @@
+
+#pragma once
+
+#include <vector>
+
+namespace msdfgen {
+
+/// The points where a horizontal line crosses the outline of a shape, which tell whether points on the line are inside the shape.
+class Scanline {
+
+public:
+    struct Intersection {
+        /// The x coordinate of the crossing.
+        double x;
+        /// The vertical direction of the crossing edge, 1 upwards and -1 downwards.
+        int direction;
+    };
+
+    /// Replaces the intersections. They may be given in any order.
+    void setIntersections(const std::vector<Intersection> &intersections);
+#ifdef MSDFGEN_USE_CPP11
+    void setIntersections(std::vector<Intersection> &&intersections);
+#endif
+    /// Returns the winding number of the outline around the point at x on the line.
+    int winding(double x) const;
+    /// Returns true if the point at x on the line is inside the shape according to the nonzero fill rule.
+    bool filled(double x) const;
+
+private:
+    /// Sorted by x, with each direction replaced by the sum of the directions up to and including it.
+    std::vector<Intersection> intersections;
+
+    void preprocess();
+
+};
+
+}
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include "Contour.h"
+#include "Scanline.h"
 
 namespace msdfgen {
 
@@ -25,10 +26,20 @@ public:
     Contour & addContour();
     /// Normalizes the shape geometry for distance field generation.
     void normalize();
+    /// Replaces cubic curves with quadratic curves, or line segments if toLines is set, that deviate from them by at most tolerance.
+    /// Distances from these are computed in closed form, which is faster than the iterative search for cubic curves.
+    /// To bound the error in pixels of a distance field generated with a given scale, set tolerance to pixels/scale.
+    void approximateCubics(double tolerance, bool toLines = false);
+    /// Removes edges that cost distance evaluations without changing the outline by more than tolerance: drops zero-length edges,
+    /// replaces nearly flat curves with line segments and merges runs of nearly collinear line segments. Must be called before edge coloring.
+    /// To bound the change in pixels of a distance field generated with a given scale, set tolerance to pixels/scale. Returns the number of edges removed.
+    int simplify(double tolerance);
     /// Performs basic checks to determine if the object represents a valid shape.
     bool validate() const;
     /// Computes the shape's bounding box.
     void bounds(double &l, double &b, double &r, double &t) const;
+    /// Finds the intersections of the shape's outline with the horizontal line at y.
+    void scanline(Scanline &line, double y) const;
 
 };
 
@@ -4,22 +4,30 @@
 namespace msdfgen {
 
 /// Represents a signed distance and alignment, which together can be compared to uniquely determine the closest edge segment.
-class SignedDistance {
+template <typename T>
+class SignedDistanceT {
 
 public:
-    static const SignedDistance INFINITE;
+    static const SignedDistanceT INFINITE;
 
-    double distance;
-    double dot;
+    T distance;
+    T dot;
 
-    SignedDistance();
-    SignedDistance(double dist, double d);
-
-    friend bool operator<(SignedDistance a, SignedDistance b);
-    friend bool operator>(SignedDistance a, SignedDistance b);
-    friend bool operator<=(SignedDistance a, SignedDistance b);
-    friend bool operator>=(SignedDistance a, SignedDistance b);
+    SignedDistanceT();
+    SignedDistanceT(T dist, T d);
 
 };
 
+template <typename T>
+bool operator<(SignedDistanceT<T> a, SignedDistanceT<T> b);
+template <typename T>
+bool operator>(SignedDistanceT<T> a, SignedDistanceT<T> b);
+template <typename T>
+bool operator<=(SignedDistanceT<T> a, SignedDistanceT<T> b);
+template <typename T>
+bool operator>=(SignedDistanceT<T> a, SignedDistanceT<T> b);
+
+typedef SignedDistanceT<double> SignedDistance;
+typedef SignedDistanceT<float> SignedDistancef;
+
 }
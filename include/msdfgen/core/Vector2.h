@@ -7,60 +7,75 @@
 namespace msdfgen {
 
 /**
-* A 2-dimensional euclidean vector with double precision.
+* A 2-dimensional euclidean vector, instantiated with double precision (Vector2) and single precision (Vector2f).
 * Implementation based on the Vector2 template from Artery Engine.
 * @author Viktor Chlumsky
 */
-struct Vector2 {
+template <typename T>
+struct Vector2T {
 
-    double x, y;
+    typedef T Scalar;
 
-    Vector2(double val = 0);
-    Vector2(double x, double y);
+    T x, y;
+
+    Vector2T(T val = 0);
+    Vector2T(T x, T y);
+    /// Converts a vector of a different precision.
+    template <typename S>
+    explicit Vector2T(const Vector2T<S> &other) : x(T(other.x)), y(T(other.y)) { }
     /// Sets the vector to zero.
     void reset();
     /// Sets individual elements of the vector.
-    void set(double x, double y);
+    void set(T x, T y);
     /// Returns the vector's length.
-    double length() const;
+    T length() const;
     /// Returns the angle of the vector in radians (atan2).
-    double direction() const;
+    T direction() const;
     /// Returns the normalized vector - one that has the same direction but unit length.
-    Vector2 normalize(bool allowZero = false) const;
+    Vector2T normalize(bool allowZero = false) const;
     /// Returns a vector with the same length that is orthogonal to this one.
-    Vector2 getOrthogonal(bool polarity = true) const;
+    Vector2T getOrthogonal(bool polarity = true) const;
     /// Returns a vector with unit length that is orthogonal to this one.
-    Vector2 getOrthonormal(bool polarity = true, bool allowZero = false) const;
+    Vector2T getOrthonormal(bool polarity = true, bool allowZero = false) const;
     /// Returns a vector projected along this one.
-    Vector2 project(const Vector2 &vector, bool positive = false) const;
+    Vector2T project(const Vector2T &vector, bool positive = false) const;
     operator const void *() const;
     bool operator!() const;
-    bool operator==(const Vector2 &other) const;
-    bool operator!=(const Vector2 &other) const;
-    Vector2 operator+() const;
-    Vector2 operator-() const;
-    Vector2 operator+(const Vector2 &other) const;
-    Vector2 operator-(const Vector2 &other) const;
-    Vector2 operator*(const Vector2 &other) const;
-    Vector2 operator/(const Vector2 &other) const;
-    Vector2 operator*(double value) const;
-    Vector2 operator/(double value) const;
-    Vector2 & operator+=(const Vector2 &other);
-    Vector2 & operator-=(const Vector2 &other);
-    Vector2 & operator*=(const Vector2 &other);
-    Vector2 & operator/=(const Vector2 &other);
-    Vector2 & operator*=(double value);
-    Vector2 & operator/=(double value);
-    /// Dot product of two vectors.
-    friend double dotProduct(const Vector2 &a, const Vector2 &b);
-    /// A special version of the cross product for 2D vectors (returns scalar value).
-    friend double crossProduct(const Vector2 &a, const Vector2 &b);
-    friend Vector2 operator*(double value, const Vector2 &vector);
-    friend Vector2 operator/(double value, const Vector2 &vector);
+    bool operator==(const Vector2T &other) const;
+    bool operator!=(const Vector2T &other) const;
+    Vector2T operator+() const;
+    Vector2T operator-() const;
+    Vector2T operator+(const Vector2T &other) const;
+    Vector2T operator-(const Vector2T &other) const;
+    Vector2T operator*(const Vector2T &other) const;
+    Vector2T operator/(const Vector2T &other) const;
+    Vector2T operator*(T value) const;
+    Vector2T operator/(T value) const;
+    Vector2T & operator+=(const Vector2T &other);
+    Vector2T & operator-=(const Vector2T &other);
+    Vector2T & operator*=(const Vector2T &other);
+    Vector2T & operator/=(const Vector2T &other);
+    Vector2T & operator*=(T value);
+    Vector2T & operator/=(T value);
 
 };
 
+/// Dot product of two vectors.
+template <typename T>
+T dotProduct(const Vector2T<T> &a, const Vector2T<T> &b);
+/// A special version of the cross product for 2D vectors (returns scalar value).
+template <typename T>
+T crossProduct(const Vector2T<T> &a, const Vector2T<T> &b);
+template <typename T>
+Vector2T<T> operator*(typename Vector2T<T>::Scalar value, const Vector2T<T> &vector);
+template <typename T>
+Vector2T<T> operator/(typename Vector2T<T>::Scalar value, const Vector2T<T> &vector);
+
+typedef Vector2T<double> Vector2;
+typedef Vector2T<float> Vector2f;
+
 /// A vector may also represent a point, which shall be differentiated semantically using the alias Point2.
 typedef Vector2 Point2;
+typedef Vector2f Point2f;
 
 }
@@ -0,0 +1,39 @@
+
+#pragma once
+
+#include "Vector2.h"
+#include "SignedDistance.h"
+#include "CompiledShape.h"
+
+namespace msdfgen {
+
+/// Instruction sets that the batch signed distance kernels can be implemented with. SIMD_NONE uses plain scalar code.
+enum SimdLevel {
+    SIMD_NONE,
+    SIMD_SSE2,
+    SIMD_AVX2,
+    SIMD_NEON
+};
+
+/// Implementations of signedDistanceBatch for each edge segment type, using a specific instruction set.
+/// Single precision kernels process twice as many points per instruction.
+template <typename T>
+struct EdgeKernelsT {
+    SimdLevel level;
+    void (*linear)(const CompiledLinearSegmentT<T> &segment, const T *x, const T *y, SignedDistanceT<T> *distance, T *param);
+    void (*quadratic)(const CompiledQuadraticSegmentT<T> &segment, const T *x, const T *y, SignedDistanceT<T> *distance, T *param);
+    void (*cubic)(const CompiledCubicSegmentT<T> &segment, const T *x, const T *y, SignedDistanceT<T> *distance, T *param);
+};
+
+typedef EdgeKernelsT<double> EdgeKernels;
+
+/// Returns the best instruction set supported by the processor the program is running on.
+SimdLevel detectSimdLevel();
+/// Returns the kernels of the given precision currently used by signedDistanceBatch.
+template <typename T>
+const EdgeKernelsT<T> & getEdgeKernels();
+/// Overrides the instruction set used by the kernels, e.g. to compare their output. If the processor does not support it, the best supported one is used instead.
+/// Must not be called while distance fields are being generated.
+void setSimdLevel(SimdLevel level);
+
+}
@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include "Vector2.h"
 #include "SignedDistance.h"
 #include "EdgeColor.h"
@@ -10,6 +11,10 @@ namespace msdfgen {
 // Parameters for iterative search of closest point on a cubic Bezier curve. Increase for higher precision.
 #define MSDFGEN_CUBIC_SEARCH_STARTS 4
 #define MSDFGEN_CUBIC_SEARCH_STEPS 4
+// Number of points processed by a single call to signedDistanceBatch.
+#define MSDFGEN_BATCH_SIZE 4
+// Number of points processed at once in single precision, where a SIMD register holds twice as many values.
+#define MSDFGEN_FLOAT_BATCH_SIZE 8
 
 /// An abstract edge segment.
 class EdgeSegment {
@@ -19,6 +24,9 @@ public:
 
     EdgeSegment(EdgeColor edgeColor = WHITE) : color(edgeColor) { }
     virtual ~EdgeSegment() { }
+    /// Edge segments are allocated from the current thread's EdgeArena if there is one.
+    static void * operator new(size_t size);
+    static void operator delete(void *ptr);
     /// Creates a copy of the edge segment.
     virtual EdgeSegment * clone() const = 0;
     /// Returns the point on the edge specified by the parameter (between 0 and 1).
@@ -27,8 +35,14 @@ public:
     virtual Vector2 direction(double param) const = 0;
     /// Returns the minimum signed distance between origin and the edge.
     virtual SignedDistance signedDistance(Point2 origin, double &param) const = 0;
+    /// Computes signedDistance for MSDFGEN_BATCH_SIZE points at once, given by their x and y coordinates. The results are identical.
+    virtual void signedDistanceBatch(const double *x, const double *y, SignedDistance *distance, double *param) const;
     /// Converts a previously retrieved signed distance from origin to pseudo-distance.
     virtual void distanceToPseudoDistance(SignedDistance &distance, Point2 origin, double param) const;
+    /// Finds the points where the edge crosses the horizontal line at y, stores their x coordinates and the vertical direction
+    /// of the edge there (1 upwards, -1 downwards), and returns their number. Points at exactly y count as below the line,
+    /// so that a crossing at the shared endpoint of two edges is found exactly once.
+    virtual int scanlineIntersections(double x[3], int dy[3], double y) const = 0;
     /// Adjusts the bounding box to fit the edge segment.
     virtual void bounds(double &l, double &b, double &r, double &t) const = 0;
 
@@ -52,6 +66,8 @@ public:
     Point2 point(double param) const;
     Vector2 direction(double param) const;
     SignedDistance signedDistance(Point2 origin, double &param) const;
+    void signedDistanceBatch(const double *x, const double *y, SignedDistance *distance, double *param) const;
+    int scanlineIntersections(double x[3], int dy[3], double y) const;
     void bounds(double &l, double &b, double &r, double &t) const;
 
     void moveStartPoint(Point2 to);
@@ -71,6 +87,8 @@ public:
     Point2 point(double param) const;
     Vector2 direction(double param) const;
     SignedDistance signedDistance(Point2 origin, double &param) const;
+    void signedDistanceBatch(const double *x, const double *y, SignedDistance *distance, double *param) const;
+    int scanlineIntersections(double x[3], int dy[3], double y) const;
     void bounds(double &l, double &b, double &r, double &t) const;
 
     void moveStartPoint(Point2 to);
@@ -90,6 +108,8 @@ public:
     Point2 point(double param) const;
     Vector2 direction(double param) const;
     SignedDistance signedDistance(Point2 origin, double &param) const;
+    void signedDistanceBatch(const double *x, const double *y, SignedDistance *distance, double *param) const;
+    int scanlineIntersections(double x[3], int dy[3], double y) const;
     void bounds(double &l, double &b, double &r, double &t) const;
 
     void moveStartPoint(Point2 to);
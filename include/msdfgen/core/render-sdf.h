@@ -3,17 +3,22 @@
 
 #include "Vector2.h"
 #include "Bitmap.h"
+#include "Executor.h"
 
 namespace msdfgen {
 
-/// Reconstructs the shape's appearance into output from the distance field sdf.
-void renderSDF(Bitmap<float> &output, const Bitmap<float> &sdf, double pxRange = 0);
-void renderSDF(Bitmap<FloatRGB> &output, const Bitmap<float> &sdf, double pxRange = 0);
-void renderSDF(Bitmap<float> &output, const Bitmap<FloatRGB> &sdf, double pxRange = 0);
-void renderSDF(Bitmap<FloatRGB> &output, const Bitmap<FloatRGB> &sdf, double pxRange = 0);
+/// Reconstructs the shape's appearance into output from the distance field sdf. The field is sampled bilinearly in single precision,
+/// a row at a time with SIMD instructions where available, and bands of rows are rendered in parallel if an executor is specified.
+void renderSDF(Bitmap<float> &output, const Bitmap<float> &sdf, double pxRange = 0, Executor *executor = NULL);
+void renderSDF(Bitmap<FloatRGB> &output, const Bitmap<float> &sdf, double pxRange = 0, Executor *executor = NULL);
+void renderSDF(Bitmap<float> &output, const Bitmap<FloatRGB> &sdf, double pxRange = 0, Executor *executor = NULL);
+void renderSDF(Bitmap<FloatRGB> &output, const Bitmap<FloatRGB> &sdf, double pxRange = 0, Executor *executor = NULL);
+/// Reconstructs the shape's appearance from an 8-bit distance field in place, such as a glyph's cell in an atlas page.
+void renderSDF(Bitmap<float> &output, const ByteBitmapConstRef &sdf, double pxRange = 0, Executor *executor = NULL);
+void renderSDF(Bitmap<FloatRGB> &output, const ByteBitmapConstRef &sdf, double pxRange = 0, Executor *executor = NULL);
 
 /// Snaps the values of the floating-point bitmaps into one of the 256 values representable in a standard 8-bit bitmap.
-void simulate8bit(Bitmap<float> &bitmap);
-void simulate8bit(Bitmap<FloatRGB> &bitmap);
+void simulate8bit(Bitmap<float> &bitmap, Executor *executor = NULL);
+void simulate8bit(Bitmap<FloatRGB> &bitmap, Executor *executor = NULL);
 
 }
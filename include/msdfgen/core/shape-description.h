@@ -3,6 +3,7 @@
 
 #include <cstdlib>
 #include <cstdio>
+#include <vector>
 #include "Shape.h"
 
 namespace msdfgen {
@@ -10,7 +11,17 @@ namespace msdfgen {
 /// Deserializes a text description of a vector shape into output.
 bool readShapeDescription(FILE *input, Shape &output, bool *colorsSpecified = NULL);
 bool readShapeDescription(const char *input, Shape &output, bool *colorsSpecified = NULL);
+/// Deserializes a text description of the specified length in memory, which doesn't need to be null-terminated.
+/// Apart from the edges and contours of output, nothing is allocated.
+bool readShapeDescription(const char *input, size_t length, Shape &output, bool *colorsSpecified = NULL);
 /// Serializes a shape object into a text description.
 bool writeShapeDescription(FILE *output, const Shape &shape);
 
+/// Serializes a shape object into a compact binary encoding, which is appended to output.
+/// Reading it back with readShapeBinary reproduces the shape exactly, including edge types, colors and inverseYAxis.
+bool writeShapeBinary(std::vector<unsigned char> &output, const Shape &shape);
+/// Deserializes a shape from the binary encoding at input, and returns the number of bytes read, or 0 if the encoding is invalid.
+/// Shapes encoded one after another can be read in bulk by advancing input by the returned length.
+size_t readShapeBinary(const unsigned char *input, size_t length, Shape &output);
+
 }
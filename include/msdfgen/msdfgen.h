@@ -18,7 +18,13 @@
 #include "msdfgen/core/arithmetics.hpp"
 #include "msdfgen/core/Vector2.h"
 #include "msdfgen/core/Shape.h"
+#include "msdfgen/core/EdgeArena.h"
+#include "msdfgen/core/Scanline.h"
+#include "msdfgen/core/CompiledShape.h"
 #include "msdfgen/core/Bitmap.h"
+#include "msdfgen/core/Executor.h"
+#include "msdfgen/core/EdgeIndex.h"
+#include "msdfgen/core/edge-kernels.h"
 #include "msdfgen/core/edge-coloring.h"
 #include "msdfgen/core/render-sdf.h"
 #include "msdfgen/core/save-bmp.h"
@@ -28,13 +34,73 @@
 
 namespace msdfgen {
 
+/// Settings shared by the distance field generators.
+struct GeneratorConfig {
+    /// If set, rows of the output are distributed across the executor's threads.
+    Executor *executor;
+    /// If set, the nearest edges of each pixel are evaluated first for the next pixels of the row,
+    /// so that more of the other edges can be skipped. The output is the same either way.
+    bool warmStart;
+    /// If set, only pixels within range/2 of the outline, whose values are between 0 and 1, are computed exactly. The others are set to
+    /// 0 outside and 1 inside the shape, as found by the nonzero fill rule along each row, instead of values beyond that interval.
+    /// Once clamped, single-channel distance fields are unchanged. In pseudo-distance and multi-channel fields, the channels of
+    /// such pixels used to follow the extended edges, which can be nearer or on the other side, so this also removes stray values.
+    bool bandLimited;
+    /// If set, the output is first divided into blocks of pixels, which are recursively split in four unless the distance at their center
+    /// shows that all of their pixels are farther than range/2 from the outline. Such blocks are filled with 0 or 1 without evaluating their
+    /// pixels, which saves most of the work on large outputs. Once clamped, single-channel distance fields are unchanged, while pseudo-distance
+    /// and multi-channel values far from the outline saturate. Only whole blocks are filled, so the output is not the same as with bandLimited,
+    /// which also saturates single pixels and runs.
+    bool adaptive;
+
+    GeneratorConfig(Executor *executor = NULL, bool warmStart = true, bool bandLimited = false, bool adaptive = false) :
+        executor(executor), warmStart(warmStart), bandLimited(bandLimited), adaptive(adaptive) { }
+};
+
 /// Generates a conventional single-channel signed distance field.
-void generateSDF(Bitmap<float> &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate);
+void generateSDF(Bitmap<float> &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config = GeneratorConfig());
+/// The precision of the distance computation is given by the compiled shape, see CompiledShapef.
+template <typename T>
+void generateSDF(Bitmap<float> &output, const CompiledShapeT<T> &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config = GeneratorConfig());
 
 /// Generates a single-channel signed pseudo-distance field.
-void generatePseudoSDF(Bitmap<float> &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate);
+void generatePseudoSDF(Bitmap<float> &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config = GeneratorConfig());
+template <typename T>
+void generatePseudoSDF(Bitmap<float> &output, const CompiledShapeT<T> &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config = GeneratorConfig());
 
 /// Generates a multi-channel signed distance field. Edge colors must be assigned first! (see edgeColoringSimple)
-void generateMSDF(Bitmap<FloatRGB> &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, double edgeThreshold = 1.00000001);
+void generateMSDF(Bitmap<FloatRGB> &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, double edgeThreshold = 1.00000001, const GeneratorConfig &config = GeneratorConfig());
+/// Generates a multi-channel signed distance field from a shape compiled after its edges have been colored.
+/// Compiling the shape once saves time when several distance fields are generated from it.
+template <typename T>
+void generateMSDF(Bitmap<FloatRGB> &output, const CompiledShapeT<T> &shape, double range, const Vector2 &scale, const Vector2 &translate, double edgeThreshold = 1.00000001, const GeneratorConfig &config = GeneratorConfig());
+
+/// Generates a single-channel signed distance field directly into 8-bit memory, see ByteBitmapRef.
+void generateSDF(const ByteBitmapRef &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config = GeneratorConfig());
+template <typename T>
+void generateSDF(const ByteBitmapRef &output, const CompiledShapeT<T> &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config = GeneratorConfig());
+
+/// Generates a single-channel signed pseudo-distance field directly into 8-bit memory.
+void generatePseudoSDF(const ByteBitmapRef &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config = GeneratorConfig());
+template <typename T>
+void generatePseudoSDF(const ByteBitmapRef &output, const CompiledShapeT<T> &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config = GeneratorConfig());
+
+/// Generates a multi-channel signed distance field directly into 8-bit memory, three bytes per pixel.
+/// Unless rows are generated concurrently, error correction only keeps three rows of floating-point values.
+void generateMSDF(const ByteBitmapRef &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, double edgeThreshold = 1.00000001, const GeneratorConfig &config = GeneratorConfig());
+template <typename T>
+void generateMSDF(const ByteBitmapRef &output, const CompiledShapeT<T> &shape, double range, const Vector2 &scale, const Vector2 &translate, double edgeThreshold = 1.00000001, const GeneratorConfig &config = GeneratorConfig());
+
+/// Generates a single-channel signed distance field by a Euclidean distance transform of the points where the outline crosses
+/// horizontal and vertical lines spaced 1/supersampling pixels apart. Its cost grows with the number of pixels and the length of the outline,
+/// but not with the number of edges, which makes it faster than generateSDF for complex shapes. Pixels within half the range of the outline
+/// are corrected to the exact distance from the edges around the nearest crossing, values farther away saturate. The sign follows
+/// the non-zero fill rule, so overlapping contours are handled. Rows are distributed across the executor's threads.
+void generateDistanceTransformSDF(Bitmap<float> &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, int supersampling = 2, Executor *executor = NULL);
+void generateDistanceTransformSDF(const ByteBitmapRef &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, int supersampling = 2, Executor *executor = NULL);
+
+/// Resolves clashes between neighboring pixels of a multi-channel distance field, called by generateMSDF.
+/// Works in place without allocating memory for glyph-sized bitmaps, bands of rows are distributed across the executor's threads.
+void msdfErrorCorrection(Bitmap<FloatRGB> &output, const Vector2 &threshold, Executor *executor = NULL);
 
 }
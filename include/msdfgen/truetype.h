@@ -0,0 +1,47 @@
+
+#pragma once
+
+#include <cstddef>
+#include "msdfgen/core/Shape.h"
+
+namespace msdfgen {
+
+/// Reads glyph outlines straight from the glyf and loca tables of a TrueType font in memory, including composite glyphs.
+/// It produces the same shapes as loadGlyph does through FreeType, but keeps no state while loading a glyph,
+/// so one object can be used by any number of threads at once. Fonts with CFF outlines are not supported, see isValid.
+class TrueTypeFont {
+
+public:
+    /// Locates the tables of the face with the specified index in a font file or collection. The data is not copied
+    /// and must stay in memory while the object is used.
+    TrueTypeFont(const unsigned char *data, size_t size, int faceIndex = 0);
+    /// Returns whether the font has TrueType outlines that can be read.
+    bool isValid() const;
+    /// Returns the number of glyphs in the font.
+    int getGlyphCount() const;
+    /// Returns the size of one EM in font units.
+    int getUnitsPerEm() const;
+    /// Loads the shape of a glyph in the same coordinates as loadGlyph, and optionally its advance.
+    bool loadGlyph(Shape &output, unsigned int glyphIndex, double *advance = NULL) const;
+
+private:
+    struct Outline;
+
+    const unsigned char *data;
+    size_t size;
+    bool valid;
+    size_t glyf, glyfLength;
+    size_t loca, locaLength;
+    size_t hmtx, hmtxLength;
+    int glyphCount;
+    int hMetricCount;
+    int unitsPerEm;
+    bool longLoca;
+
+    /// Appends the points of a glyph to outline, transforming composite glyphs the same way as FreeType.
+    bool loadOutline(Outline &outline, unsigned int glyphIndex, int &advance, int depth) const;
+    int getAdvance(unsigned int glyphIndex) const;
+
+};
+
+}
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "msdfgen/core/Shape.h"
+#include "msdfgen/truetype.h"
 
 typedef struct FT_FaceRec_*  FT_Face;
 
@@ -13,6 +14,8 @@ bool getFontScale(double &output, FT_Face face);
 bool getFontWhitespaceWidth(double &spaceAdvance, double &tabAdvance, FT_Face face);
 /// Loads the shape prototype of a glyph from font file using the glyph index
 bool loadGlyph(Shape &output, FT_Face face, unsigned int glyphIndex, double *advance = NULL, bool printInfo = false);
+/// Loads the shape prototype of a glyph with font if it has TrueType outlines, or through FreeType otherwise, such as for CFF fonts
+bool loadGlyph(Shape &output, const TrueTypeFont &font, FT_Face face, unsigned int glyphIndex, double *advance = NULL);
 /// Loads the shape prototype of a glyph from font file using a character code
 bool loadChar(Shape &output, FT_Face face, unsigned long charCode, double *advance = NULL);
 /// Returns the kerning distance adjustment between two specific glyphs.
@@ -19,8 +19,14 @@ if( NOT TARGET Cinder-SdfText )
 			"${CINDER_SDFTEXT_SOURCE_PATH}/msdfgen/core/shape-description.cpp"
 			"${CINDER_SDFTEXT_SOURCE_PATH}/msdfgen/core/SignedDistance.cpp"
 			"${CINDER_SDFTEXT_SOURCE_PATH}/msdfgen/core/Vector2.cpp"
+			"${CINDER_SDFTEXT_SOURCE_PATH}/msdfgen/core/EdgeArena.cpp"
+			"${CINDER_SDFTEXT_SOURCE_PATH}/msdfgen/core/Scanline.cpp"
+			"${CINDER_SDFTEXT_SOURCE_PATH}/msdfgen/core/CompiledShape.cpp"
+			"${CINDER_SDFTEXT_SOURCE_PATH}/msdfgen/core/edge-kernels.cpp"
+			"${CINDER_SDFTEXT_SOURCE_PATH}/msdfgen/core/EdgeIndex.cpp"
 			"${CINDER_SDFTEXT_SOURCE_PATH}/msdfgen/msdfgen.cpp"
 			"${CINDER_SDFTEXT_SOURCE_PATH}/msdfgen/util.cpp"
+			"${CINDER_SDFTEXT_SOURCE_PATH}/msdfgen/truetype.cpp"
 		)
 
 	if( CMAKE_SYSTEM_NAME MATCHES "Darwin" )
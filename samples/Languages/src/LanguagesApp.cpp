@@ -59,9 +59,10 @@ void LanguagesApp::setup()
 
 void LanguagesApp::generateSdf()
 {
+	// Each string only needs a handful of glyphs, so all the fonts share the same atlas pages
 	for( auto &ti : mTextInfos ) {
 		ti.mFont = gl::SdfText::Font( ti.mName, ti.mSize );
-		ti.mSdfText = gl::SdfText::create( ti.mFont, gl::SdfText::Format(), ti.mStr );
+		ti.mSdfText = gl::SdfText::create( ti.mFont, gl::SdfText::Format().sharedPages(), ti.mStr );
 	}
 }
 
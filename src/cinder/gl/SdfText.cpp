@@ -64,8 +64,18 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "msdfgen/msdfgen.h"
 #include "msdfgen/util.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <deque>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <thread>
+#include <tuple>
 #include <vector>
 #include <boost/algorithm/string.hpp>
 
@@ -121,8 +131,12 @@ static std::string kSdfFragShader =
 	"}\n"
 	"\n"	
 	"void main(void) {\n"
+	"#if defined( SDF_SINGLE_CHANNEL )\n"
+	"    float sigDist = texture2D( uTex0, TexCoord ).r;\n"
+	"#else\n"
 	"    vec3 sample = texture2D( uTex0, TexCoord ).rgb;\n"
 	"    float sigDist = median( sample.r, sample.g, sample.b );\n"
+	"#endif\n"
 	"    float c = calcDiff( TexCoord );\n"
 	"    vec2 ps = vec2( 1.0 / uTexSize.x, 1.0 / uTexSize.y );\n"
 	"    float dfdx = calcDiff( TexCoord + vec2( ps.x ) ) - c;\n"
@@ -136,10 +150,15 @@ static std::string kSdfFragShader =
 	"    // Calculate derivates\n"
 	"    vec2 Jdx = dFdx( uv );\n"
 	"    vec2 Jdy = dFdy( uv );\n"
+	"#if defined( SDF_SINGLE_CHANNEL )\n"
+	"    // Sample SDF texture (1 channel) and calculate signed distance (in texels).\n"
+	"    float sigDist = texture2D( uTex0, TexCoord ).r - 0.5;\n"
+	"#else\n"
 	"    // Sample SDF texture (3 channels).\n"
 	"    vec3 sample = texture2D( uTex0, TexCoord ).rgb;\n"
 	"    // Calculate signed distance (in texels).\n"
 	"    float sigDist = median( sample.r, sample.g, sample.b ) - 0.5;\n"
+	"#endif\n"
 	"    // For proper anti-aliasing, we need to calculate signed distance in pixels. We do this using derivatives.\n"
 	"    vec2 gradDist = safeNormalize( vec2( dFdx( sigDist ), dFdy( sigDist ) ) );\n"
 	"    vec2 grad = vec2( gradDist.x * Jdx.x + gradDist.y * Jdy.x, gradDist.x * Jdx.y + gradDist.y * Jdy.y );\n"
@@ -193,10 +212,15 @@ static std::string kSdfFragShader =
 	"    // Calculate derivates\n"
 	"    vec2 Jdx = dFdx( uv );\n"
 	"    vec2 Jdy = dFdy( uv );\n"
+	"#if defined( SDF_SINGLE_CHANNEL )\n"
+	"    // Sample SDF texture (1 channel) and calculate signed distance (in texels).\n"
+	"    float sigDist = texture( uTex0, TexCoord ).r - 0.5;\n"
+	"#else\n"
 	"    // Sample SDF texture (3 channels).\n"
 	"    vec3 sample = texture( uTex0, TexCoord ).rgb;\n"
 	"    // Calculate signed distance (in texels).\n"
 	"    float sigDist = median( sample.r, sample.g, sample.b ) - 0.5;\n"
+	"#endif\n"
 	"    // For proper anti-aliasing, we need to calculate signed distance in pixels. We do this using derivatives.\n"
 	"    vec2 gradDist = safeNormalize( vec2( dFdx( sigDist ), dFdy( sigDist ) ) );\n"
 	"    vec2 grad = vec2( gradDist.x * Jdx.x + gradDist.y * Jdy.x, gradDist.x * Jdx.y + gradDist.y * Jdy.y );\n"
@@ -213,6 +237,591 @@ static std::string kSdfFragShader =
 #endif
 
 static gl::GlslProgRef sDefaultShader;
+static gl::GlslProgRef sDefaultSingleChannelShader;
+
+// =================================================================================================
+// GlyphWorkQueue
+// =================================================================================================
+//! Distributes a fixed number of jobs across a number of workers. Each worker starts out with its
+//! own contiguous block of jobs and takes work from the front of it. A worker that runs out steals
+//! from the back of another worker's block, so a handful of expensive glyphs can't leave the rest
+//! of the workers idle.
+class GlyphWorkQueue {
+public:
+	GlyphWorkQueue( size_t numJobs, size_t numWorkers );
+
+	size_t	getNumWorkers() const { return mQueues.size(); }
+
+	//! Calls \a fn( worker, job ) for every job. The calling thread acts as worker 0.
+	void	run( const std::function<void( size_t, size_t )> &fn );
+
+private:
+	struct Queue {
+		std::mutex			mMutex;
+		std::deque<size_t>	mJobs;
+	};
+
+	std::vector<std::unique_ptr<Queue>>	mQueues;
+
+	bool	pop( size_t worker, size_t *outJob );
+	void	work( size_t worker, const std::function<void( size_t, size_t )> &fn );
+};
+
+GlyphWorkQueue::GlyphWorkQueue( size_t numJobs, size_t numWorkers )
+{
+	numWorkers = std::max<size_t>( 1, numWorkers );
+	for( size_t i = 0; i < numWorkers; ++i ) {
+		mQueues.push_back( std::unique_ptr<Queue>( new Queue() ) );
+	}
+
+	for( size_t job = 0; job < numJobs; ++job ) {
+		size_t worker = ( job * numWorkers ) / std::max<size_t>( 1, numJobs );
+		mQueues[worker]->mJobs.push_back( job );
+	}
+}
+
+bool GlyphWorkQueue::pop( size_t worker, size_t *outJob )
+{
+	// Own queue first...
+	{
+		Queue &queue = *mQueues[worker];
+		std::lock_guard<std::mutex> lock( queue.mMutex );
+		if( ! queue.mJobs.empty() ) {
+			*outJob = queue.mJobs.front();
+			queue.mJobs.pop_front();
+			return true;
+		}
+	}
+
+	// ...then steal from the others
+	for( size_t i = 1; i < mQueues.size(); ++i ) {
+		Queue &queue = *mQueues[( worker + i ) % mQueues.size()];
+		std::lock_guard<std::mutex> lock( queue.mMutex );
+		if( ! queue.mJobs.empty() ) {
+			*outJob = queue.mJobs.back();
+			queue.mJobs.pop_back();
+			return true;
+		}
+	}
+
+	// No jobs are ever added after construction, so empty queues mean we're done
+	return false;
+}
+
+void GlyphWorkQueue::work( size_t worker, const std::function<void( size_t, size_t )> &fn )
+{
+	size_t job = 0;
+	while( pop( worker, &job ) ) {
+		fn( worker, job );
+	}
+}
+
+void GlyphWorkQueue::run( const std::function<void( size_t, size_t )> &fn )
+{
+	std::vector<std::thread> threads;
+	for( size_t worker = 1; worker < mQueues.size(); ++worker ) {
+		threads.push_back( std::thread( &GlyphWorkQueue::work, this, worker, std::cref( fn ) ) );
+	}
+
+	work( 0, fn );
+
+	for( auto& thread : threads ) {
+		thread.join();
+	}
+}
+
+// =================================================================================================
+// GlyphPacker
+// =================================================================================================
+//! Packs glyph cells of different sizes into a page with the skyline bottom-left heuristic. The
+//! skyline is the top edge of the cells placed so far, every cell goes where its top ends up lowest.
+//! Cells are kept \a spacing apart, the spacing after the last cell on a row or column may fall
+//! off the edge of the page.
+class GlyphPacker {
+public:
+	GlyphPacker( const ivec2 &size, const ivec2 &spacing );
+
+	const ivec2&	getSize() const { return mSize; }
+
+	//! Places a cell of \a size and writes its upper left corner to \a outPosition. Returns false if the page has no room for it.
+	bool	insert( const ivec2 &size, ivec2 *outPosition );
+
+	//! Returns the smallest page no larger than \a maxSize that fits all of \a sizes, inserted in the order given. Page 
+	//! sizes are powers of two, or \a maxSize itself. Returns ivec2( 0 ) if the cells need more than one page.
+	static ivec2	calculatePageSize( const std::vector<ivec2> &sizes, const ivec2 &spacing, const ivec2 &maxSize );
+
+private:
+	struct Segment {
+		int mX;
+		int mY;
+		int mWidth;
+	};
+
+	ivec2					mSize;
+	ivec2					mSpacing;
+	std::vector<Segment>	mSkyline;
+};
+
+GlyphPacker::GlyphPacker( const ivec2 &size, const ivec2 &spacing )
+	: mSize( size ), mSpacing( spacing )
+{
+	Segment segment = { 0, 0, mSize.x + mSpacing.x };
+	mSkyline.push_back( segment );
+}
+
+bool GlyphPacker::insert( const ivec2 &size, ivec2 *outPosition )
+{
+	const ivec2 extent = size + mSpacing;
+	const ivec2 bounds = mSize + mSpacing;
+
+	// Find the segment to start the cell at, the cell rests on the highest segment it spans
+	size_t bestIndex = mSkyline.size();
+	ivec2 bestPosition = ivec2( 0 );
+	int bestTop = std::numeric_limits<int>::max();
+	for( size_t i = 0; i < mSkyline.size(); ++i ) {
+		const int x = mSkyline[i].mX;
+		if( ( x + extent.x ) > bounds.x ) {
+			break;
+		}
+
+		int y = 0;
+		int remaining = extent.x;
+		for( size_t j = i; remaining > 0; ++j ) {
+			y = std::max( y, mSkyline[j].mY );
+			remaining -= mSkyline[j].mWidth;
+		}
+
+		const int top = y + extent.y;
+		if( ( top <= bounds.y ) && ( top < bestTop ) ) {
+			bestIndex = i;
+			bestPosition = ivec2( x, y );
+			bestTop = top;
+		}
+	}
+
+	if( bestIndex == mSkyline.size() ) {
+		return false;
+	}
+
+	// Raise the skyline over the cell...
+	Segment segment = { bestPosition.x, bestTop, extent.x };
+	mSkyline.insert( mSkyline.begin() + bestIndex, segment );
+	const int right = segment.mX + segment.mWidth;
+	size_t next = bestIndex + 1;
+	while( ( next < mSkyline.size() ) && ( mSkyline[next].mX < right ) ) {
+		const int overlap = right - mSkyline[next].mX;
+		if( overlap < mSkyline[next].mWidth ) {
+			mSkyline[next].mX += overlap;
+			mSkyline[next].mWidth -= overlap;
+			break;
+		}
+		mSkyline.erase( mSkyline.begin() + next );
+	}
+
+	// ...and merge segments at the same height
+	for( size_t i = 1; i < mSkyline.size(); ) {
+		if( mSkyline[i - 1].mY == mSkyline[i].mY ) {
+			mSkyline[i - 1].mWidth += mSkyline[i].mWidth;
+			mSkyline.erase( mSkyline.begin() + i );
+		}
+		else {
+			++i;
+		}
+	}
+
+	*outPosition = bestPosition;
+	return true;
+}
+
+ivec2 GlyphPacker::calculatePageSize( const std::vector<ivec2> &sizes, const ivec2 &spacing, const ivec2 &maxSize )
+{
+	// The cells limit how small the page can get
+	ivec2 minSize = ivec2( 1 );
+	int64_t area = 0;
+	for( const auto& size : sizes ) {
+		minSize.x = std::max( minSize.x, size.x );
+		minSize.y = std::max( minSize.y, size.y );
+		area += static_cast<int64_t>( size.x + spacing.x ) * static_cast<int64_t>( size.y + spacing.y );
+	}
+
+	// Candidate widths and heights
+	std::vector<int> widths, heights;
+	for( int width = 16; width < maxSize.x; width *= 2 ) {
+		widths.push_back( width );
+	}
+	widths.push_back( maxSize.x );
+	for( int height = 16; height < maxSize.y; height *= 2 ) {
+		heights.push_back( height );
+	}
+	heights.push_back( maxSize.y );
+
+	// Smallest area first, and the squarest of the pages with the same area
+	std::vector<ivec2> candidates;
+	for( int width : widths ) {
+		for( int height : heights ) {
+			const int64_t pageArea = static_cast<int64_t>( width + spacing.x ) * static_cast<int64_t>( height + spacing.y );
+			if( ( width >= minSize.x ) && ( height >= minSize.y ) && ( pageArea >= area ) ) {
+				candidates.push_back( ivec2( width, height ) );
+			}
+		}
+	}
+	std::sort( candidates.begin(), candidates.end(), []( const ivec2 &a, const ivec2 &b ) {
+		const int64_t areaA = static_cast<int64_t>( a.x ) * static_cast<int64_t>( a.y );
+		const int64_t areaB = static_cast<int64_t>( b.x ) * static_cast<int64_t>( b.y );
+		if( areaA != areaB ) {
+			return areaA < areaB;
+		}
+		if( std::max( a.x, a.y ) != std::max( b.x, b.y ) ) {
+			return std::max( a.x, a.y ) < std::max( b.x, b.y );
+		}
+		return a.x > b.x;
+	} );
+
+	for( const auto& candidate : candidates ) {
+		GlyphPacker packer( candidate, spacing );
+		bool fits = true;
+		ivec2 position;
+		for( size_t i = 0; fits && ( i < sizes.size() ); ++i ) {
+			fits = packer.insert( sizes[i], &position );
+		}
+		if( fits ) {
+			return candidate;
+		}
+	}
+
+	return ivec2( 0 );
+}
+
+// =================================================================================================
+// GlyphOutlineCache
+// =================================================================================================
+//! Glyph outlines parsed by msdfgen, with their bounds, advance and metrics, keyed by face and glyph
+//! index. Measuring the glyphs for the atlas cache key, laying out and rendering the atlas and building
+//! the glyph metrics all share them, so each glyph is loaded once. Outlines of TrueType faces are read
+//! from the font data by msdfgen::TrueTypeFont, other faces fall back to FreeType. Once the estimated memory 
+//! of the outlines exceeds the budget, the least recently used ones are evicted. Outlines that have 
+//! been handed out stay valid for as long as they're referenced.
+class GlyphOutlineCache {
+public:
+	struct Outline {
+		//! Whether msdfgen::loadGlyph succeeded, the shape, bounds and advance are only valid if it did
+		bool						mLoaded = false;
+		msdfgen::Shape				mShape;
+		//! Bounds of the shape
+		double						mLeft = 0.0, mBottom = 0.0, mRight = 0.0, mTop = 0.0;
+		//! Advance as reported by msdfgen::loadGlyph
+		double						mAdvance = 0.0;
+		//! Metrics of the glyph at the face's character size
+		SdfText::Font::GlyphMetrics	mMetrics = {};
+		//! Estimated memory used by the outline
+		size_t						mBytes = 0;
+	};
+
+	using OutlineRef = std::shared_ptr<const Outline>;
+
+	//! Budget of the cache shared by all fonts, which holds the outlines of several thousand glyphs
+	static const size_t kDefaultBudget = 32 * 1024 * 1024;
+
+	GlyphOutlineCache( size_t budget = kDefaultBudget ) : mBudget( budget ) {}
+
+	//! Returns the outline of \a glyph in \a face, loading it on a miss. Must be called without an active msdfgen::EdgeArena, since cached edges outlive it.
+	OutlineRef	get( FT_Face face, SdfText::Font::Glyph glyph );
+	//! Removes all outlines of \a face
+	void		evict( FT_Face face );
+
+	//! Sets the estimated memory, in bytes, that outlines are kept in the cache up to
+	void		setBudget( size_t bytes );
+	size_t		getBudget() const;
+	//! Returns the estimated memory, in bytes, of the outlines in the cache
+	size_t		getSize() const;
+
+private:
+	using Key = std::pair<FT_Face, SdfText::Font::Glyph>;
+
+	struct Entry {
+		OutlineRef					mOutline;
+		std::list<Key>::iterator	mRecent;
+	};
+
+	mutable std::mutex		mMutex;
+	size_t					mBudget = 0;
+	size_t					mSize = 0;
+	std::map<Key, Entry>	mEntries;
+	//! Keys from the most to the least recently used
+	std::list<Key>			mRecent;
+	//! Native outline readers of the faces, invalid ones for faces that aren't TrueType
+	std::map<FT_Face, std::unique_ptr<msdfgen::TrueTypeFont>>	mFonts;
+
+	OutlineRef				load( FT_Face face, SdfText::Font::Glyph glyph );
+	void					trim();
+};
+
+GlyphOutlineCache::OutlineRef GlyphOutlineCache::get( FT_Face face, SdfText::Font::Glyph glyph )
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	const Key key = std::make_pair( face, glyph );
+	auto it = mEntries.find( key );
+	if( mEntries.end() != it ) {
+		mRecent.splice( mRecent.begin(), mRecent, it->second.mRecent );
+		return it->second.mOutline;
+	}
+
+	OutlineRef outline = load( face, glyph );
+	mRecent.push_front( key );
+	Entry entry;
+	entry.mOutline = outline;
+	entry.mRecent = mRecent.begin();
+	mEntries[key] = entry;
+	mSize += outline->mBytes;
+	trim();
+	return outline;
+}
+
+void GlyphOutlineCache::evict( FT_Face face )
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	for( auto it = mEntries.begin(); it != mEntries.end(); ) {
+		if( face == it->first.first ) {
+			mSize -= it->second.mOutline->mBytes;
+			mRecent.erase( it->second.mRecent );
+			it = mEntries.erase( it );
+		}
+		else {
+			++it;
+		}
+	}
+	mFonts.erase( face );
+}
+
+void GlyphOutlineCache::setBudget( size_t bytes )
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	mBudget = bytes;
+	trim();
+}
+
+size_t GlyphOutlineCache::getBudget() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mBudget;
+}
+
+size_t GlyphOutlineCache::getSize() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mSize;
+}
+
+GlyphOutlineCache::OutlineRef GlyphOutlineCache::load( FT_Face face, SdfText::Font::Glyph glyph )
+{
+	std::shared_ptr<Outline> outline = std::make_shared<Outline>();
+	outline->mBytes = sizeof( Outline );
+
+	auto fontIt = mFonts.find( face );
+	if( mFonts.end() == fontIt ) {
+		const unsigned char *data = face->stream->base;
+		size_t size = data ? static_cast<size_t>( face->stream->size ) : 0;
+		fontIt = mFonts.insert( std::make_pair( face, std::unique_ptr<msdfgen::TrueTypeFont>( new msdfgen::TrueTypeFont( data, size, static_cast<int>( face->face_index & 0xFFFF ) ) ) ) ).first;
+	}
+
+	if( msdfgen::loadGlyph( outline->mShape, *fontIt->second, face, glyph, &outline->mAdvance ) ) {
+		outline->mLoaded = true;
+		outline->mShape.bounds( outline->mLeft, outline->mBottom, outline->mRight, outline->mTop );
+		// Every edge is counted as the largest segment type
+		outline->mBytes += outline->mShape.contours.capacity() * sizeof( msdfgen::Contour );
+		for( const auto& contour : outline->mShape.contours ) {
+			outline->mBytes += contour.edges.capacity() * ( sizeof( msdfgen::EdgeHolder ) + sizeof( msdfgen::CubicSegment ) );
+		}
+	}
+
+	// The metrics are hinted at the character size, which only FreeType provides
+	FT_Load_Glyph( face, glyph, FT_LOAD_DEFAULT );
+	FT_GlyphSlot slot = face->glyph;
+	outline->mMetrics.advance = vec2( slot->linearHoriAdvance, slot->linearVertAdvance ) / 65536.0f;
+	outline->mMetrics.minimum = vec2( slot->metrics.horiBearingX, slot->metrics.vertBearingY - slot->metrics.height ) / 65536.0f;
+	outline->mMetrics.maximum = vec2( slot->metrics.horiBearingX + slot->metrics.width, slot->metrics.vertBearingY ) / 65536.0f;
+
+	return outline;
+}
+
+void GlyphOutlineCache::trim()
+{
+	while( ( mSize > mBudget ) && ( ! mRecent.empty() ) ) {
+		auto it = mEntries.find( mRecent.back() );
+		mSize -= it->second.mOutline->mBytes;
+		mEntries.erase( it );
+		mRecent.pop_back();
+	}
+}
+
+// =================================================================================================
+// AtlasBitmap
+// =================================================================================================
+//! Texels of an atlas page or of a single glyph. Multi-channel fields are stored as RGB, 
+//! single-channel fields as one channel so their textures are R8.
+class AtlasBitmap {
+public:
+	AtlasBitmap() {}
+	//! Creates a black bitmap of \a size
+	AtlasBitmap( const ivec2 &size, bool singleChannel );
+
+	bool			isSingleChannel() const { return mSingleChannel; }
+	Area			getBounds() const { return mSingleChannel ? mChannel.getBounds() : mSurface.getBounds(); }
+	//! Returns the texel at \a position, the channels of a texel are next to each other
+	uint8_t*		getData( const ivec2 &position );
+	size_t			getPixelInc() const { return mSingleChannel ? static_cast<size_t>( mChannel.getIncrement() ) : static_cast<size_t>( mSurface.getPixelInc() ); }
+	size_t			getRowBytes() const { return mSingleChannel ? static_cast<size_t>( mChannel.getRowBytes() ) : static_cast<size_t>( mSurface.getRowBytes() ); }
+
+	//! Copies \a srcArea of \a src, which must have as many channels, offset by \a relativeOffset
+	void			copyFrom( const AtlasBitmap &src, const Area &srcArea, const ivec2 &relativeOffset );
+	//! Creates a texture of the bitmap
+	gl::TextureRef	createTexture() const;
+	//! Uploads \a area of the bitmap to \a texture, all of it if \a area is empty
+	void			update( const gl::TextureRef &texture, const Area &area = Area( 0, 0, 0, 0 ) ) const;
+
+private:
+	bool			mSingleChannel = false;
+	Surface8u		mSurface;
+	Channel8u		mChannel;
+};
+
+AtlasBitmap::AtlasBitmap( const ivec2 &size, bool singleChannel )
+	: mSingleChannel( singleChannel )
+{
+	if( mSingleChannel ) {
+		mChannel = Channel8u( size.x, size.y );
+		ip::fill( &mChannel, static_cast<uint8_t>( 0 ) );
+	}
+	else {
+		mSurface = Surface8u( size.x, size.y, false );
+		ip::fill( &mSurface, Color8u( 0, 0, 0 ) );
+	}
+}
+
+uint8_t* AtlasBitmap::getData( const ivec2 &position )
+{
+	uint8_t *data = mSingleChannel ? mChannel.getData() : mSurface.getData();
+	return data + ( position.y * getRowBytes() ) + ( position.x * getPixelInc() );
+}
+
+void AtlasBitmap::copyFrom( const AtlasBitmap &src, const Area &srcArea, const ivec2 &relativeOffset )
+{
+	if( mSingleChannel ) {
+		mChannel.copyFrom( src.mChannel, srcArea, relativeOffset );
+	}
+	else {
+		mSurface.copyFrom( src.mSurface, srcArea, relativeOffset );
+	}
+}
+
+gl::TextureRef AtlasBitmap::createTexture() const
+{
+	return mSingleChannel ? gl::Texture::create( mChannel ) : gl::Texture::create( mSurface );
+}
+
+void AtlasBitmap::update( const gl::TextureRef &texture, const Area &area ) const
+{
+	const bool wholeBitmap = ( 0 == area.getWidth() ) || ( 0 == area.getHeight() );
+	if( mSingleChannel && wholeBitmap ) {
+		texture->update( mChannel );
+	}
+	else if( mSingleChannel ) {
+		texture->update( mChannel, area );
+	}
+	else if( wholeBitmap ) {
+		texture->update( mSurface );
+	}
+	else {
+		texture->update( mSurface, area );
+	}
+}
+
+// =================================================================================================
+// AtlasPagePool
+// =================================================================================================
+//! Atlas pages that the glyphs of several SdfText instances are packed into, so fonts with small
+//! charsets don't each get their own mostly empty textures. Pages are only shared between formats
+//! that agree on the page size, tile spacing and everything that changes how the field is sampled.
+//! A page keeps its surface so glyphs added later can be uploaded, and lives for as long as an atlas
+//! uses it. The space of glyphs whose atlas is gone isn't reused.
+class AtlasPagePool {
+public:
+	struct Page {
+		Page( const ivec2 &size, const ivec2 &spacing, bool singleChannel );
+
+		AtlasBitmap		mBitmap;
+		GlyphPacker		mPacker;
+		gl::TextureRef	mTexture;
+	};
+
+	using PageRef = std::shared_ptr<Page>;
+
+	//! Returns the pages that formats like \a format share, in the order they were created
+	std::vector<PageRef>	getPages( const SdfText::Format &format );
+	//! Adds an empty page, the size of the format's textures, to the pages formats like \a format share
+	PageRef					createPage( const SdfText::Format &format );
+
+private:
+	struct Key {
+		ivec2	mTextureSize;
+		ivec2	mTileSpacing;
+		vec2	mSdfScale;
+		float	mSdfRange;
+		bool	mDistanceTransform;
+		bool	mSingleChannel;
+		bool operator<( const Key &rhs ) const {
+			return std::tie( mTextureSize.x, mTextureSize.y, mTileSpacing.x, mTileSpacing.y, mSdfScale.x, mSdfScale.y, mSdfRange, mDistanceTransform, mSingleChannel ) <
+				   std::tie( rhs.mTextureSize.x, rhs.mTextureSize.y, rhs.mTileSpacing.x, rhs.mTileSpacing.y, rhs.mSdfScale.x, rhs.mSdfScale.y, rhs.mSdfRange, rhs.mDistanceTransform, rhs.mSingleChannel );
+		}
+	};
+
+	std::map<Key, std::vector<std::weak_ptr<Page>>>	mPages;
+
+	static Key	createKey( const SdfText::Format &format );
+};
+
+AtlasPagePool::Page::Page( const ivec2 &size, const ivec2 &spacing, bool singleChannel )
+	: mBitmap( size, singleChannel ), mPacker( size, spacing )
+{
+}
+
+AtlasPagePool::Key AtlasPagePool::createKey( const SdfText::Format &format )
+{
+	Key result;
+	result.mTextureSize = format.getTextureSize();
+	result.mTileSpacing = format.getSdfTileSpacing();
+	result.mSdfScale = format.getSdfScale();
+	result.mSdfRange = format.getSdfRange();
+	result.mDistanceTransform = format.isDistanceTransform();
+	result.mSingleChannel = format.isSingleChannel();
+	return result;
+}
+
+std::vector<AtlasPagePool::PageRef> AtlasPagePool::getPages( const SdfText::Format &format )
+{
+	std::vector<PageRef> result;
+	auto& pages = mPages[AtlasPagePool::createKey( format )];
+	for( auto it = pages.begin(); it != pages.end(); ) {
+		PageRef page = it->lock();
+		if( page ) {
+			result.push_back( page );
+			++it;
+		}
+		else {
+			it = pages.erase( it );
+		}
+	}
+	return result;
+}
+
+AtlasPagePool::PageRef AtlasPagePool::createPage( const SdfText::Format &format )
+{
+	PageRef result = std::make_shared<Page>( format.getTextureSize(), format.getSdfTileSpacing(), format.isSingleChannel() );
+	mPages[AtlasPagePool::createKey( format )].push_back( result );
+	return result;
+}
 
 // =================================================================================================
 // SdfText::TextureAtlas
@@ -220,235 +829,915 @@ static gl::GlslProgRef sDefaultShader;
 class SdfText::TextureAtlas {
 public:
 
-	struct CacheKey {
-		std::string mFamilyName;
-		std::string mStyleName;
-		std::string mUtf8Chars;
-		ivec2		mTextureSize = ivec2( 0 );
-		ivec2		mSdfBitmapSize = ivec2( 0 );
-		bool operator==( const CacheKey& rhs ) const { 
-			return ( mFamilyName == rhs.mFamilyName ) &&
-				   ( mStyleName == rhs.mStyleName ) && 
-				   ( mUtf8Chars == rhs.mUtf8Chars ) &&
-				   ( mTextureSize == rhs.mTextureSize ) &&
-				   ( mSdfBitmapSize == rhs.mSdfBitmapSize );
+	struct CacheKey {
+		std::string mFamilyName;
+		std::string mStyleName;
+		std::string mUtf8Chars;
+		ivec2		mTextureSize = ivec2( 0 );
+		ivec2		mSdfBitmapSize = ivec2( 0 );
+		// Everything in the format that changes the generated texels or whether the pages are shared
+		vec2		mSdfScale = vec2( 0.0f );
+		float		mSdfRange = 0.0f;
+		float		mSdfAngle = 0.0f;
+		ivec2		mTileSpacing = ivec2( 0 );
+		bool		mSharedPages = false;
+		bool		mSinglePrecision = false;
+		float		mCubicTolerance = 0.0f;
+		bool		mCubicsToLines = false;
+		float		mSimplifyTolerance = 0.0f;
+		bool		mBandLimited = false;
+		bool		mAdaptive = false;
+		bool		mDistanceTransform = false;
+		bool		mMaxQuality = false;
+		bool		mSingleChannel = false;
+		bool operator==( const CacheKey& rhs ) const { 
+			return ( mFamilyName == rhs.mFamilyName ) &&
+				   ( mStyleName == rhs.mStyleName ) && 
+				   ( mUtf8Chars == rhs.mUtf8Chars ) &&
+				   ( mTextureSize == rhs.mTextureSize ) &&
+				   ( mSdfBitmapSize == rhs.mSdfBitmapSize ) &&
+				   ( mSdfScale == rhs.mSdfScale ) &&
+				   ( mSdfRange == rhs.mSdfRange ) &&
+				   ( mSdfAngle == rhs.mSdfAngle ) &&
+				   ( mTileSpacing == rhs.mTileSpacing ) &&
+				   ( mSharedPages == rhs.mSharedPages ) &&
+				   ( mSinglePrecision == rhs.mSinglePrecision ) &&
+				   ( mCubicTolerance == rhs.mCubicTolerance ) &&
+				   ( mCubicsToLines == rhs.mCubicsToLines ) &&
+				   ( mSimplifyTolerance == rhs.mSimplifyTolerance ) &&
+				   ( mBandLimited == rhs.mBandLimited ) &&
+				   ( mAdaptive == rhs.mAdaptive ) &&
+				   ( mDistanceTransform == rhs.mDistanceTransform ) &&
+				   ( mMaxQuality == rhs.mMaxQuality ) &&
+				   ( mSingleChannel == rhs.mSingleChannel );
+		}
+		bool operator!=( const CacheKey& rhs ) const {
+			return ( mFamilyName != rhs.mFamilyName ) ||
+				   ( mStyleName != rhs.mStyleName ) || 
+				   ( mUtf8Chars != rhs.mUtf8Chars ) ||
+				   ( mTextureSize != rhs.mTextureSize ) ||
+				   ( mSdfBitmapSize != rhs.mSdfBitmapSize ) ||
+				   ( mSdfScale != rhs.mSdfScale ) ||
+				   ( mSdfRange != rhs.mSdfRange ) ||
+				   ( mSdfAngle != rhs.mSdfAngle ) ||
+				   ( mTileSpacing != rhs.mTileSpacing ) ||
+				   ( mSharedPages != rhs.mSharedPages ) ||
+				   ( mSinglePrecision != rhs.mSinglePrecision ) ||
+				   ( mCubicTolerance != rhs.mCubicTolerance ) ||
+				   ( mCubicsToLines != rhs.mCubicsToLines ) ||
+				   ( mSimplifyTolerance != rhs.mSimplifyTolerance ) ||
+				   ( mBandLimited != rhs.mBandLimited ) ||
+				   ( mAdaptive != rhs.mAdaptive ) ||
+				   ( mDistanceTransform != rhs.mDistanceTransform ) ||
+				   ( mMaxQuality != rhs.mMaxQuality ) ||
+				   ( mSingleChannel != rhs.mSingleChannel );
+		}
+	};
+
+	typedef std::vector<std::pair<CacheKey, SdfText::TextureAtlasRef>> AtlasCacher;
+
+	// ---------------------------------------------------------------------------------------------
+
+	virtual ~TextureAtlas();
+
+	using OutlineMap = std::unordered_map<SdfText::Font::Glyph, GlyphOutlineCache::OutlineRef>;
+
+	//! Glyphs are packed into pages of \a pagePool if one is given, otherwise the atlas gets pages of its own.
+	static SdfText::TextureAtlasRef create( FT_Face face, GlyphOutlineCache &outlines, const SdfText::Format &format, const std::vector<SdfText::Font::Glyph> &glyphIndices, AtlasPagePool *pagePool = nullptr );
+	//! Creates the atlases from outlines that were loaded beforehand, such as from an outline pack. Glyphs without a loaded outline in \a glyphOutlines are left out.
+	//! A \a growable atlas keeps pages of the texture size, and their surfaces, so glyphs can be added later.
+	static SdfText::TextureAtlasRef create( const OutlineMap &glyphOutlines, bool invertSdf, const SdfText::Format &format, const std::vector<SdfText::Font::Glyph> &glyphIndices, AtlasPagePool *pagePool = nullptr, bool growable = false );
+
+	static ivec2 calculateSdfBitmapSize( const vec2 &sdfScale, const ivec2& sdfPadding, const vec2 &maxGlyphSize );
+	//! Returns whether the SDF of \a face needs to be inverted, which is the case for OTF fonts since their contours wind CCW
+	static bool isInvertedSdf( FT_Face face );
+	//! Returns the number of workers to render \a numJobs glyphs with, \a threadCount of 0 means one per hardware thread.
+	static size_t calculateThreadCount( uint32_t threadCount, size_t numJobs );
+
+private:
+	TextureAtlas();
+	TextureAtlas( const OutlineMap &glyphOutlines, bool invertSdf, const SdfText::Format &format, const std::vector<SdfText::Font::Glyph> &glyphIndices, AtlasPagePool *pagePool, bool growable );
+	friend class SdfText;
+
+	// Cell of a glyph that has yet to be packed
+	struct GlyphCell {
+		uint32_t glyphIndex;
+		ivec2    size;
+	};
+
+	// Where a glyph was packed
+	struct RenderGlyph {
+		uint32_t glyphIndex;
+		size_t   pageIndex;
+		ivec2    position;
+		ivec2    size;
+	};
+
+	// Glyph that was rendered into a cell of its own, to be copied into a page
+	struct RenderedGlyph {
+		AtlasBitmap	mBitmap;
+		uint32_t	mSimplifiedEdges = 0;
+	};
+
+	using RenderedGlyphMap = std::unordered_map<SdfText::Font::Glyph, RenderedGlyph>;
+
+	// Glyph to render and where to put it
+	struct RenderJob {
+		uint32_t						glyphIndex;
+		size_t							atlasIndex;
+		ivec2							position;
+		ivec2							size;
+		vec2							originOffset;
+		GlyphOutlineCache::OutlineRef	outline;
+	};
+
+	//! Renders the glyph in \a job directly into its cell in \a surface. Safe to call concurrently. Returns the number of edges removed by simplification.
+	uint32_t renderGlyph( const SdfText::Format &format, bool invertSdf, const RenderJob &job, AtlasBitmap &bitmap ) const;
+	//! Returns the size of the cell for a glyph with origin offset \a originOffset and size \a glyphSize.
+	ivec2 calculateCellSize( const vec2 &originOffset, const vec2 &glyphSize ) const;
+	//! Adds the bounds of the glyphs with loaded outlines to mGlyphInfo, returns their cells tallest first.
+	std::vector<GlyphCell> addGlyphInfo( const OutlineMap &glyphOutlines, const std::vector<SdfText::Font::Glyph> &glyphIndices );
+	//! Sets the texture coordinates of \a renderGlyphs and renders them into their pages.
+	void renderGlyphs( const OutlineMap &glyphOutlines, bool invertSdf, const SdfText::Format &format, const std::vector<RenderGlyph> &renderGlyphs );
+	//! Renders \a renderGlyphs like renderGlyphs, or copies them from \a renderedGlyphs if it's given.
+	void fillGlyphs( const OutlineMap &glyphOutlines, bool invertSdf, const SdfText::Format &format, const std::vector<RenderGlyph> &renderGlyphs, const RenderedGlyphMap *renderedGlyphs );
+	//! Uploads the cells of \a renderGlyphs, or all of every page if \a wholePages is set, creating the textures that are missing.
+	void uploadPages( const std::vector<RenderGlyph> &renderGlyphs, bool wholePages );
+
+	//! Packs \a cells into the first of \a packers with room for each, adding packers of \a pageSize up to \a maxPages. Returns false if a cell doesn't fit. Every cell must fit an empty page, which addGlyphs makes sure of.
+	static bool packCells( const std::vector<GlyphCell> &cells, const ivec2 &pageSize, const ivec2 &spacing, size_t maxPages, std::vector<GlyphPacker> *packers, std::vector<RenderGlyph> *renderGlyphs );
+	//! Growable atlases: packs and renders glyphs that were missing, or copies them from \a renderedGlyphs. If the pages of a dynamic atlas are full, the least recently drawn glyphs are evicted and the rest are repacked.
+	void addGlyphs( const OutlineMap &glyphOutlines, bool invertSdf, const SdfText::Format &format, const std::vector<SdfText::Font::Glyph> &glyphIndices, const RenderedGlyphMap *renderedGlyphs = nullptr );
+
+	//! Starts generating \a glyphIndices on a background thread, they're added to the atlas by updateAsync.
+	void startAsync( const OutlineMap &glyphOutlines, bool invertSdf, const SdfText::Format &format, const std::vector<SdfText::Font::Glyph> &glyphIndices );
+	//! Background thread of startAsync, renders the glyphs in batches into cells of their own.
+	void generateAsync();
+	//! Adds the glyphs the background thread finished since the last call. Must be called from the GL thread.
+	void updateAsync();
+
+	//! Pages the glyphs were rendered to, empty for atlases loaded from an SDFT file. Shared pages can hold glyphs of other atlases.
+	std::vector<AtlasPagePool::PageRef>	mPages;
+	std::vector<gl::TextureRef>			mTextures;
+	SdfText::Font::GlyphInfoMap			mGlyphInfo;
+
+	//! Growable atlases keep their surfaces so glyphs can be added. Dynamic atlases generate glyphs as they're needed, and evict the least recently drawn ones once mMaxPages are full
+	bool												mGrowable = false;
+	bool												mDynamic = false;
+	size_t												mMaxPages = 0;
+	uint64_t											mDrawStamp = 0;
+	std::unordered_map<SdfText::Font::Glyph, uint64_t>	mLastDrawn;
+	std::set<SdfText::Font::Glyph>						mPendingGlyphs;
+
+	// Glyphs that createAsync generates in the background
+	struct AsyncState {
+		AsyncState() : mCanceled( false ), mGenerated( false ) {}
+
+		SdfText::Format						mFormat;
+		bool								mInvertSdf = false;
+		OutlineMap							mGlyphOutlines;
+		std::vector<SdfText::Font::Glyph>	mGlyphIndices;
+		size_t								mNumResident = 0;
+		size_t								mNumUploaded = 0;
+		std::thread							mThread;
+		std::atomic<bool>					mCanceled;
+		std::atomic<bool>					mGenerated;
+		// Glyphs the background thread finished, including the ones that couldn't be loaded
+		std::mutex							mMutex;
+		std::vector<SdfText::Font::Glyph>	mFinishedGlyphs;
+		RenderedGlyphMap					mRenderedGlyphs;
+	};
+
+	std::unique_ptr<AsyncState>							mAsync;
+
+	//! Base scale that SDF generator uses is size 32 at 72 DPI. A scale of 1.5, 2.0, and 3.0 translates to size 48, 64 and 96 and 72 DPI.
+	vec2						mSdfScale = vec2( 1.0f );
+	vec2						mSdfPadding = vec2( 2.0f );
+	ivec2						mSdfBitmapSize = ivec2( 0 );
+	vec2						mMaxGlyphSize = vec2( 0.0f );
+	float						mMaxAscent = 0.0f;
+	float						mMaxDescent = 0.0f;
+	//! Single-channel fields are stored in R8 pages and drawn with the single-channel shader
+	bool						mSingleChannel = false;
+};
+
+SdfText::TextureAtlas::TextureAtlas()
+{
+}
+
+SdfText::TextureAtlas::~TextureAtlas()
+{
+	// The background thread renders with the atlas
+	if( mAsync && mAsync->mThread.joinable() ) {
+		mAsync->mCanceled = true;
+		mAsync->mThread.join();
+	}
+}
+
+SdfText::TextureAtlas::TextureAtlas( const OutlineMap &glyphOutlines, bool invertSdf, const SdfText::Format &format, const std::vector<SdfText::Font::Glyph> &glyphIndices, AtlasPagePool *pagePool, bool growable )
+	: mSdfScale( format.getSdfScale() ), mSdfPadding( format.getSdfPadding() ), mSingleChannel( format.isSingleChannel() )
+{
+	const ivec2& tileSpacing = format.getSdfTileSpacing();
+	mDynamic = format.isDynamic() && ( nullptr == pagePool );
+	mGrowable = ( growable && ( nullptr == pagePool ) ) || mDynamic;
+
+	// Build glyph information that will be needed later
+	std::vector<GlyphCell> pendingCells = addGlyphInfo( glyphOutlines, glyphIndices );
+
+	// Largest cell, cells are sized to each glyph now but the size is still part of the cache key and the cache file
+	mSdfBitmapSize = SdfText::TextureAtlas::calculateSdfBitmapSize( mSdfScale, mSdfPadding, mMaxGlyphSize );
+
+	// Pages a dynamic atlas can have before glyphs are evicted, other atlases grow as much as they need
+	if( mDynamic ) {
+		const size_t pageBytes = static_cast<size_t>( format.getTextureWidth() ) * static_cast<size_t>( format.getTextureHeight() ) * ( mSingleChannel ? 1 : 3 );
+		mMaxPages = std::max<size_t>( 1, format.getDynamicBudget() / std::max<size_t>( 1, pageBytes ) );
+	}
+	else {
+		mMaxPages = std::numeric_limits<size_t>::max();
+	}
+
+	std::vector<RenderGlyph> placedGlyphs;
+
+	// Build the atlases
+	if( ( nullptr != pagePool ) || mGrowable ) {
+		// Each glyph goes in the first page with room for it. Shared pages come from the pool and a new 
+		// page is added to the pool when none has room. Growable atlases use pages of the texture size 
+		// from the format so there's room for the glyphs added later.
+		std::vector<AtlasPagePool::PageRef> pages;
+		if( nullptr != pagePool ) {
+			pages = pagePool->getPages( format );
+		}
+		for( const auto& cell : pendingCells ) {
+			RenderGlyph renderGlyph;
+			renderGlyph.glyphIndex = cell.glyphIndex;
+			renderGlyph.size = cell.size;
+
+			size_t index = 0;
+			while( ( index < pages.size() ) && ( ! pages[index]->mPacker.insert( cell.size, &renderGlyph.position ) ) ) {
+				++index;
+			}
+			if( pages.size() == index ) {
+				pages.push_back( ( nullptr != pagePool ) ? pagePool->createPage( format ) : std::make_shared<AtlasPagePool::Page>( format.getTextureSize(), tileSpacing, mSingleChannel ) );
+				if( ! pages.back()->mPacker.insert( cell.size, &renderGlyph.position ) ) {
+					throw ci::Exception( "Glyph doesn't fit in the texture size" );
+				}
+			}
+
+			// Only the pages that hold glyphs of this atlas become its textures
+			auto pageIt = std::find( mPages.begin(), mPages.end(), pages[index] );
+			renderGlyph.pageIndex = static_cast<size_t>( pageIt - mPages.begin() );
+			if( mPages.end() == pageIt ) {
+				mPages.push_back( pages[index] );
+			}
+			placedGlyphs.push_back( renderGlyph );
+		}
+	}
+	else {
+		// Each page is the smallest that fits the remaining glyphs, if none does the page is the 
+		// texture size from the format and the glyphs that don't fit move on to the next page.
+		while( ! pendingCells.empty() ) {
+			std::vector<ivec2> cellSizes;
+			for( const auto& cell : pendingCells ) {
+				cellSizes.push_back( cell.size );
+			}
+			ivec2 pageSize = GlyphPacker::calculatePageSize( cellSizes, tileSpacing, format.getTextureSize() );
+			if( ivec2( 0 ) == pageSize ) {
+				pageSize = format.getTextureSize();
+			}
+
+			AtlasPagePool::PageRef page = std::make_shared<AtlasPagePool::Page>( pageSize, tileSpacing, mSingleChannel );
+			std::vector<GlyphCell> remainingCells;
+			const size_t numPlacedGlyphs = placedGlyphs.size();
+			for( const auto& cell : pendingCells ) {
+				RenderGlyph renderGlyph;
+				renderGlyph.glyphIndex = cell.glyphIndex;
+				renderGlyph.pageIndex = mPages.size();
+				renderGlyph.size = cell.size;
+				if( page->mPacker.insert( cell.size, &renderGlyph.position ) ) {
+					placedGlyphs.push_back( renderGlyph );
+				}
+				else {
+					remainingCells.push_back( cell );
+				}
+			}
+
+			if( placedGlyphs.size() == numPlacedGlyphs ) {
+				throw ci::Exception( "Glyph doesn't fit in the texture size" );
+			}
+
+			mPages.push_back( page );
+			pendingCells.swap( remainingCells );
+		}
+	}
+
+	renderGlyphs( glyphOutlines, invertSdf, format, placedGlyphs );
+	uploadPages( placedGlyphs, false );
+
+	// Only shared and growable pages get more glyphs later
+	if( ( nullptr == pagePool ) && ( ! mGrowable ) ) {
+		for( auto& page : mPages ) {
+			page->mBitmap = AtlasBitmap();
+		}
+	}
+}
+
+ivec2 SdfText::TextureAtlas::calculateCellSize( const vec2 &originOffset, const vec2 &glyphSize ) const
+{
+	// The generator puts the glyph origin at the padding on the left and the baseline |bottom| above
+	// the bottom edge, so the cell has to reach the glyph's right and top from there. Drawing only 
+	// depends on the cell's size, so that's the only thing that changes.
+	const vec2 extent = vec2( 
+		std::max( originOffset.x + glyphSize.x, 0.0f ), 
+		originOffset.y + glyphSize.y + std::fabs( originOffset.y ) );
+	return SdfText::TextureAtlas::calculateSdfBitmapSize( mSdfScale, mSdfPadding, extent );
+}
+
+std::vector<SdfText::TextureAtlas::GlyphCell> SdfText::TextureAtlas::addGlyphInfo( const OutlineMap &glyphOutlines, const std::vector<SdfText::Font::Glyph> &glyphIndices )
+{
+	std::vector<GlyphCell> result;
+	for( const auto& glyphIndex : glyphIndices ) {
+		// Glyph bounds, 
+		auto outlineIt = glyphOutlines.find( glyphIndex );
+		if( ( glyphOutlines.end() != outlineIt ) && outlineIt->second->mLoaded && ( mGlyphInfo.end() == mGlyphInfo.find( glyphIndex ) ) ) {
+			const GlyphOutlineCache::OutlineRef& outline = outlineIt->second;
+			const double l = outline->mLeft;
+			const double b = outline->mBottom;
+			const double r = outline->mRight;
+			const double t = outline->mTop;
+			// Glyph bounds
+			Rectf bounds = Rectf( 
+				static_cast<float>( l ), 
+				static_cast<float>( b ), 
+				static_cast<float>( r ), 
+				static_cast<float>( t ) );
+			SdfText::Font::GlyphInfo& glyphInfo = mGlyphInfo[glyphIndex];
+			glyphInfo.mOriginOffset = vec2( l, b );
+			glyphInfo.mSize = vec2( r - l, t - b );
+			// Max glyph size
+			mMaxGlyphSize.x = std::max( mMaxGlyphSize.x, bounds.getWidth() );
+			mMaxGlyphSize.y = std::max( mMaxGlyphSize.y, bounds.getHeight() );
+			// Max ascent, descent
+			mMaxAscent = std::max( mMaxAscent, static_cast<float>( t ) );
+			mMaxDescent = std::max( mMaxAscent, static_cast<float>( std::fabs( b ) ) );
+			//CI_LOG_I( (char)ch << " : " << glyphInfo.mOriginOffset );
+
+			// Cell for the glyph
+			GlyphCell cell;
+			cell.glyphIndex = glyphIndex;
+			cell.size = calculateCellSize( glyphInfo.mOriginOffset, glyphInfo.mSize );
+			result.push_back( cell );
+		}	
+	}
+
+	// Tallest cells first packs the skyline tightest, the glyph index keeps the layout deterministic
+	std::sort( result.begin(), result.end(), []( const GlyphCell &a, const GlyphCell &b ) {
+		if( a.size.y != b.size.y ) {
+			return a.size.y > b.size.y;
+		}
+		if( a.size.x != b.size.x ) {
+			return a.size.x > b.size.x;
+		}
+		return a.glyphIndex < b.glyphIndex;
+	} );
+
+	return result;
+}
+
+void SdfText::TextureAtlas::renderGlyphs( const OutlineMap &glyphOutlines, bool invertSdf, const SdfText::Format &format, const std::vector<RenderGlyph> &renderGlyphs )
+{
+	// Build the list of render jobs. Texture coordinates are assigned up front so that the workers 
+	// never write to mGlyphInfo.
+	std::vector<RenderJob> renderJobs;
+	for( const auto& renderGlyph : renderGlyphs ) {
+		auto glyphInfoIt = mGlyphInfo.find( renderGlyph.glyphIndex );
+
+		// Tex coords
+		glyphInfoIt->second.mTextureIndex = static_cast<uint32_t>( renderGlyph.pageIndex );
+		glyphInfoIt->second.mTexCoords = Area( 0, 0, renderGlyph.size.x, renderGlyph.size.y ) + renderGlyph.position;
+
+		RenderJob job;
+		job.glyphIndex = renderGlyph.glyphIndex;
+		job.atlasIndex = renderGlyph.pageIndex;
+		job.position = renderGlyph.position;
+		job.size = renderGlyph.size;
+		job.originOffset = glyphInfoIt->second.mOriginOffset;
+		job.outline = glyphOutlines.at( renderGlyph.glyphIndex );
+		renderJobs.push_back( job );
+	}
+
+	// Workers copy the outlines from the cache, so they don't touch FreeType
+	const size_t numWorkers = SdfText::TextureAtlas::calculateThreadCount( format.getThreadCount(), renderJobs.size() );
+
+	// Render the glyphs - every glyph writes to its own cell so the result doesn't depend on the 
+	// number of workers or the order the glyphs are rendered in.
+	// Each worker allocates edges from its own arena, which is reset after each glyph, so that outlines 
+	// are loaded, split and colored without heap allocations.
+	std::vector<uint32_t> simplifiedEdges( renderJobs.size(), 0 );
+	std::vector<std::unique_ptr<msdfgen::EdgeArena>> workerArenas;
+	for( size_t i = 0; i < numWorkers; ++i ) {
+		workerArenas.push_back( std::unique_ptr<msdfgen::EdgeArena>( new msdfgen::EdgeArena() ) );
+	}
+	GlyphWorkQueue workQueue( renderJobs.size(), numWorkers );
+	workQueue.run( [&]( size_t worker, size_t jobIndex ) {
+		const RenderJob& job = renderJobs[jobIndex];
+		msdfgen::EdgeArena& arena = *workerArenas[worker];
+		{
+			msdfgen::EdgeArena::Scope arenaScope( arena );
+			simplifiedEdges[jobIndex] = renderGlyph( format, invertSdf, job, mPages[job.atlasIndex]->mBitmap );
+		}
+		arena.reset();
+	} );
+
+	for( size_t jobIndex = 0; jobIndex < renderJobs.size(); ++jobIndex ) {
+		mGlyphInfo[renderJobs[jobIndex].glyphIndex].mSimplifiedEdges = simplifiedEdges[jobIndex];
+	}
+}
+
+void SdfText::TextureAtlas::fillGlyphs( const OutlineMap &glyphOutlines, bool invertSdf, const SdfText::Format &format, const std::vector<RenderGlyph> &renderGlyphs, const RenderedGlyphMap *renderedGlyphs )
+{
+	if( nullptr == renderedGlyphs ) {
+		this->renderGlyphs( glyphOutlines, invertSdf, format, renderGlyphs );
+		return;
+	}
+
+	for( const auto& renderGlyph : renderGlyphs ) {
+		const RenderedGlyph& rendered = renderedGlyphs->at( renderGlyph.glyphIndex );
+		mPages[renderGlyph.pageIndex]->mBitmap.copyFrom( rendered.mBitmap, rendered.mBitmap.getBounds(), renderGlyph.position );
+
+		SdfText::Font::GlyphInfo& glyphInfo = mGlyphInfo[renderGlyph.glyphIndex];
+		glyphInfo.mTextureIndex = static_cast<uint32_t>( renderGlyph.pageIndex );
+		glyphInfo.mTexCoords = Area( 0, 0, renderGlyph.size.x, renderGlyph.size.y ) + renderGlyph.position;
+		glyphInfo.mSimplifiedEdges = rendered.mSimplifiedEdges;
+	}
+}
+
+void SdfText::TextureAtlas::startAsync( const OutlineMap &glyphOutlines, bool invertSdf, const SdfText::Format &format, const std::vector<SdfText::Font::Glyph> &glyphIndices )
+{
+	mAsync.reset( new AsyncState() );
+	mAsync->mFormat = format;
+	mAsync->mInvertSdf = invertSdf;
+	mAsync->mGlyphOutlines = glyphOutlines;
+	mAsync->mGlyphIndices = glyphIndices;
+	mAsync->mThread = std::thread( &SdfText::TextureAtlas::generateAsync, this );
+}
+
+void SdfText::TextureAtlas::generateAsync()
+{
+	AsyncState& async = *mAsync;
+	const SdfText::Format& format = async.mFormat;
+
+	// The glyphs are rendered in small batches so that they show up while the rest are generated,
+	// and so that cancelling doesn't have to wait for the whole set.
+	const size_t numWorkers = SdfText::TextureAtlas::calculateThreadCount( format.getThreadCount(), async.mGlyphIndices.size() );
+	const size_t batchSize = std::max<size_t>( 32, 8 * numWorkers );
+	std::vector<std::unique_ptr<msdfgen::EdgeArena>> workerArenas;
+	for( size_t i = 0; i < numWorkers; ++i ) {
+		workerArenas.push_back( std::unique_ptr<msdfgen::EdgeArena>( new msdfgen::EdgeArena() ) );
+	}
+
+	for( size_t batchStart = 0; batchStart < async.mGlyphIndices.size(); batchStart += batchSize ) {
+		if( async.mCanceled ) {
+			break;
+		}
+
+		// Every glyph is rendered into a cell of its own since its place in the pages is only known 
+		// once it's added on the GL thread. Glyphs without an outline are finished as they are.
+		const size_t batchEnd = std::min( batchStart + batchSize, async.mGlyphIndices.size() );
+		std::vector<RenderJob> renderJobs;
+		for( size_t i = batchStart; i < batchEnd; ++i ) {
+			const SdfText::Font::Glyph glyphIndex = async.mGlyphIndices[i];
+			const GlyphOutlineCache::OutlineRef& outline = async.mGlyphOutlines.at( glyphIndex );
+			if( ! outline->mLoaded ) {
+				continue;
+			}
+
+			RenderJob job;
+			job.glyphIndex = glyphIndex;
+			job.atlasIndex = 0;
+			job.position = ivec2( 0 );
+			job.originOffset = vec2( outline->mLeft, outline->mBottom );
+			job.size = calculateCellSize( job.originOffset, vec2( outline->mRight - outline->mLeft, outline->mTop - outline->mBottom ) );
+			job.outline = outline;
+			renderJobs.push_back( job );
+		}
+
+		std::vector<RenderedGlyph> renderedGlyphs( renderJobs.size() );
+		GlyphWorkQueue workQueue( renderJobs.size(), std::min( numWorkers, std::max<size_t>( 1, renderJobs.size() ) ) );
+		workQueue.run( [&]( size_t worker, size_t jobIndex ) {
+			if( async.mCanceled ) {
+				return;
+			}
+			const RenderJob& job = renderJobs[jobIndex];
+			RenderedGlyph& rendered = renderedGlyphs[jobIndex];
+			rendered.mBitmap = AtlasBitmap( job.size, mSingleChannel );
+			msdfgen::EdgeArena& arena = *workerArenas[worker];
+			{
+				msdfgen::EdgeArena::Scope arenaScope( arena );
+				rendered.mSimplifiedEdges = renderGlyph( format, async.mInvertSdf, job, rendered.mBitmap );
+			}
+			arena.reset();
+		} );
+
+		if( async.mCanceled ) {
+			break;
+		}
+
+		std::lock_guard<std::mutex> lock( async.mMutex );
+		for( size_t i = batchStart; i < batchEnd; ++i ) {
+			async.mFinishedGlyphs.push_back( async.mGlyphIndices[i] );
+		}
+		for( size_t jobIndex = 0; jobIndex < renderJobs.size(); ++jobIndex ) {
+			async.mRenderedGlyphs[renderJobs[jobIndex].glyphIndex] = std::move( renderedGlyphs[jobIndex] );
+		}
+	}
+
+	async.mGenerated = true;
+}
+
+void SdfText::TextureAtlas::updateAsync()
+{
+	if( ! mAsync ) {
+		return;
+	}
+
+	std::vector<SdfText::Font::Glyph> finishedGlyphs;
+	RenderedGlyphMap renderedGlyphs;
+	{
+		std::lock_guard<std::mutex> lock( mAsync->mMutex );
+		finishedGlyphs.swap( mAsync->mFinishedGlyphs );
+		renderedGlyphs.swap( mAsync->mRenderedGlyphs );
+	}
+	if( finishedGlyphs.empty() ) {
+		return;
+	}
+
+	OutlineMap glyphOutlines;
+	for( const auto& glyphIndex : finishedGlyphs ) {
+		glyphOutlines[glyphIndex] = mAsync->mGlyphOutlines.at( glyphIndex );
+	}
+	// Glyphs that couldn't be loaded or don't fit a page are finished too, so progress still reaches 1
+	mAsync->mNumUploaded += finishedGlyphs.size();
+	addGlyphs( glyphOutlines, mAsync->mInvertSdf, mAsync->mFormat, finishedGlyphs, &renderedGlyphs );
+
+	if( mAsync->mGenerated && mAsync->mThread.joinable() ) {
+		mAsync->mThread.join();
+	}
+}
+
+void SdfText::TextureAtlas::uploadPages( const std::vector<RenderGlyph> &renderGlyphs, bool wholePages )
+{
+	// Area of each page that changed
+	std::vector<Area> dirtyAreas( mPages.size(), Area( 0, 0, 0, 0 ) );
+	for( const auto& renderGlyph : renderGlyphs ) {
+		Area& dirty = dirtyAreas[renderGlyph.pageIndex];
+		const Area cell = Area( 0, 0, renderGlyph.size.x, renderGlyph.size.y ) + renderGlyph.position;
+		if( ( 0 == dirty.getWidth() ) || ( 0 == dirty.getHeight() ) ) {
+			dirty = cell;
+		}
+		else {
+			dirty = Area( std::min( dirty.x1, cell.x1 ), std::min( dirty.y1, cell.y1 ), std::max( dirty.x2, cell.x2 ), std::max( dirty.y2, cell.y2 ) );
+		}
+	}
+
+	// Create textures, pages that already have one get the changed area uploaded
+	mTextures.clear();
+	for( size_t atlasIndex = 0; atlasIndex < mPages.size(); ++atlasIndex ) {
+		AtlasPagePool::Page& page = *mPages[atlasIndex];
+		if( ! page.mTexture ) {
+			page.mTexture = page.mBitmap.createTexture();
+		}
+		else if( wholePages ) {
+			page.mBitmap.update( page.mTexture );
+		}
+		else if( ( dirtyAreas[atlasIndex].getWidth() > 0 ) && ( dirtyAreas[atlasIndex].getHeight() > 0 ) ) {
+			page.mBitmap.update( page.mTexture, dirtyAreas[atlasIndex] );
+		}
+		mTextures.push_back( page.mTexture );
+
+		// Debug output
+		//writeImage( "sdfText_" + std::to_string( atlasIndex ) + ".png", page.mTexture->createSource() );
+	}
+}
+
+bool SdfText::TextureAtlas::packCells( const std::vector<GlyphCell> &cells, const ivec2 &pageSize, const ivec2 &spacing, size_t maxPages, std::vector<GlyphPacker> *packers, std::vector<RenderGlyph> *renderGlyphs )
+{
+	for( const auto& cell : cells ) {
+		RenderGlyph renderGlyph;
+		renderGlyph.glyphIndex = cell.glyphIndex;
+		renderGlyph.size = cell.size;
+
+		size_t index = 0;
+		while( ( index < packers->size() ) && ( ! (*packers)[index].insert( cell.size, &renderGlyph.position ) ) ) {
+			++index;
+		}
+		if( packers->size() == index ) {
+			if( packers->size() >= maxPages ) {
+				return false;
+			}
+			packers->push_back( GlyphPacker( pageSize, spacing ) );
+			if( ! packers->back().insert( cell.size, &renderGlyph.position ) ) {
+				throw ci::Exception( "Glyph doesn't fit in the texture size" );
+			}
+		}
+
+		renderGlyph.pageIndex = index;
+		renderGlyphs->push_back( renderGlyph );
+	}
+
+	return true;
+}
+
+void SdfText::TextureAtlas::addGlyphs( const OutlineMap &glyphOutlines, bool invertSdf, const SdfText::Format &format, const std::vector<SdfText::Font::Glyph> &glyphIndices, const RenderedGlyphMap *renderedGlyphs )
+{
+	std::vector<GlyphCell> newCells = addGlyphInfo( glyphOutlines, glyphIndices );
+	if( newCells.empty() ) {
+		return;
+	}
+
+	mSdfBitmapSize = SdfText::TextureAtlas::calculateSdfBitmapSize( mSdfScale, mSdfPadding, mMaxGlyphSize );
+
+	const ivec2& pageSize = format.getTextureSize();
+	const ivec2& tileSpacing = format.getSdfTileSpacing();
+
+	// Glyphs whose cell is larger than an empty page can never be placed. They're left out rather than
+	// throwing while drawing, and the rest of the batch is packed as usual. For atlases without a budget,
+	// such as the ones createAsync grows, this is the only way a glyph can fail to be added.
+	{
+		std::vector<GlyphCell> fittingCells;
+		size_t numOversized = 0;
+		for( const auto& cell : newCells ) {
+			GlyphPacker emptyPage( pageSize, tileSpacing );
+			ivec2 position;
+			if( emptyPage.insert( cell.size, &position ) ) {
+				fittingCells.push_back( cell );
+			}
+			else {
+				mGlyphInfo.erase( cell.glyphIndex );
+				++numOversized;
+			}
+		}
+		if( numOversized > 0 ) {
+			CI_LOG_W( numOversized << " glyph(s) don't fit in the texture size and were left out" );
+		}
+		newCells.swap( fittingCells );
+		if( newCells.empty() ) {
+			return;
+		}
+	}
+
+	// The free space of the pages comes first. The glyphs are packed with copies of the packers, so 
+	// nothing changes if they don't fit.
+	{
+		std::vector<GlyphPacker> packers;
+		for( const auto& page : mPages ) {
+			packers.push_back( page->mPacker );
 		}
-		bool operator!=( const CacheKey& rhs ) const {
-			return ( mFamilyName != rhs.mFamilyName ) ||
-				   ( mStyleName != rhs.mStyleName ) || 
-				   ( mUtf8Chars != rhs.mUtf8Chars ) ||
-				   ( mTextureSize != rhs.mTextureSize ) ||
-				   ( mSdfBitmapSize != rhs.mSdfBitmapSize );
+		std::vector<RenderGlyph> placedGlyphs;
+		if( SdfText::TextureAtlas::packCells( newCells, pageSize, tileSpacing, mMaxPages, &packers, &placedGlyphs ) ) {
+			for( size_t i = 0; i < packers.size(); ++i ) {
+				if( mPages.size() == i ) {
+					mPages.push_back( std::make_shared<AtlasPagePool::Page>( pageSize, tileSpacing, mSingleChannel ) );
+				}
+				mPages[i]->mPacker = packers[i];
+			}
+			fillGlyphs( glyphOutlines, invertSdf, format, placedGlyphs, renderedGlyphs );
+			uploadPages( placedGlyphs, false );
+			return;
+		}
+	}
+
+	// The pages are full. Glyphs that were drawn least recently are evicted and the rest are packed
+	// again, from the most recently drawn, so that they're copied to new pages rather than generated 
+	// again. Glyphs that are being drawn now are never evicted.
+	std::set<SdfText::Font::Glyph> newGlyphIndices;
+	for( const auto& cell : newCells ) {
+		newGlyphIndices.insert( cell.glyphIndex );
+	}
+	std::vector<GlyphCell> residentCells;
+	for( const auto& glyphInfoIt : mGlyphInfo ) {
+		if( newGlyphIndices.end() != newGlyphIndices.find( glyphInfoIt.first ) ) {
+			continue;
 		}
+		GlyphCell cell;
+		cell.glyphIndex = glyphInfoIt.first;
+		cell.size = glyphInfoIt.second.mTexCoords.getSize();
+		residentCells.push_back( cell );
+	}
+	auto lastDrawn = [this]( SdfText::Font::Glyph glyph ) -> uint64_t {
+		auto it = mLastDrawn.find( glyph );
+		return ( mLastDrawn.end() != it ) ? it->second : 0;
 	};
+	std::sort( residentCells.begin(), residentCells.end(), [&]( const GlyphCell &a, const GlyphCell &b ) {
+		const uint64_t drawnA = lastDrawn( a.glyphIndex );
+		const uint64_t drawnB = lastDrawn( b.glyphIndex );
+		return ( drawnA != drawnB ) ? ( drawnA > drawnB ) : ( a.glyphIndex < b.glyphIndex );
+	} );
+	size_t numProtected = 0;
+	while( ( numProtected < residentCells.size() ) && ( lastDrawn( residentCells[numProtected].glyphIndex ) >= mDrawStamp ) ) {
+		++numProtected;
+	}
 
-	typedef std::vector<std::pair<CacheKey, SdfText::TextureAtlasRef>> AtlasCacher;
+	// Evicting down to three quarters of the budget leaves room for the next glyphs, so the pages 
+	// aren't repacked for every glyph that's added
+	auto cellArea = []( const GlyphCell &cell ) -> int64_t {
+		return static_cast<int64_t>( cell.size.x ) * static_cast<int64_t>( cell.size.y );
+	};
+	const int64_t targetArea = ( static_cast<int64_t>( pageSize.x ) * static_cast<int64_t>( pageSize.y ) * static_cast<int64_t>( mMaxPages ) * 3 ) / 4;
+	int64_t area = 0;
+	for( const auto& cell : newCells ) {
+		area += cellArea( cell );
+	}
+	size_t numKept = 0;
+	while( ( numKept < residentCells.size() ) && ( ( numKept < numProtected ) || ( ( area + cellArea( residentCells[numKept] ) ) <= targetArea ) ) ) {
+		area += cellArea( residentCells[numKept] );
+		++numKept;
+	}
 
-	// ---------------------------------------------------------------------------------------------
+	std::vector<GlyphPacker> packers;
+	std::vector<RenderGlyph> placedGlyphs;
+	while( true ) {
+		std::vector<GlyphCell> cells( residentCells.begin(), residentCells.begin() + numKept );
+		cells.insert( cells.end(), newCells.begin(), newCells.end() );
+		std::sort( cells.begin(), cells.end(), []( const GlyphCell &a, const GlyphCell &b ) {
+			if( a.size.y != b.size.y ) {
+				return a.size.y > b.size.y;
+			}
+			if( a.size.x != b.size.x ) {
+				return a.size.x > b.size.x;
+			}
+			return a.glyphIndex < b.glyphIndex;
+		} );
 
-	virtual ~TextureAtlas() {}
+		packers.clear();
+		placedGlyphs.clear();
+		if( SdfText::TextureAtlas::packCells( cells, pageSize, tileSpacing, mMaxPages, &packers, &placedGlyphs ) ) {
+			break;
+		}
 
-	static SdfText::TextureAtlasRef create( FT_Face face, const SdfText::Format &format, const std::vector<SdfText::Font::Glyph> &glyphIndices );
+		// The glyphs being drawn don't fit in the budget by themselves, so it's exceeded
+		if( numKept <= numProtected ) {
+			CI_LOG_W( "Dynamic atlas budget exceeded by the glyphs being drawn" );
+			packers.clear();
+			placedGlyphs.clear();
+			SdfText::TextureAtlas::packCells( cells, pageSize, tileSpacing, std::numeric_limits<size_t>::max(), &packers, &placedGlyphs );
+			break;
+		}
 
-	static ivec2 calculateSdfBitmapSize( const vec2 &sdfScale, const ivec2& sdfPadding, const vec2 &maxGlyphSize );
+		// Evict another eighth of the glyphs that can be
+		numKept -= std::max<size_t>( 1, ( numKept - numProtected ) / 8 );
+	}
 
-private:
-	TextureAtlas();
-	TextureAtlas( FT_Face face, const SdfText::Format &format, const std::vector<SdfText::Font::Glyph> &glyphIndices );
-	friend class SdfText;
+	// Evicted glyphs are generated again if they're drawn later
+	for( size_t i = numKept; i < residentCells.size(); ++i ) {
+		mGlyphInfo.erase( residentCells[i].glyphIndex );
+		mLastDrawn.erase( residentCells[i].glyphIndex );
+	}
 
-	FT_Face							mFace = nullptr;
-	std::vector<gl::TextureRef>		mTextures;
-	SdfText::Font::GlyphInfoMap		mGlyphInfo;
+	// New pages reuse the textures of the old ones
+	std::vector<AtlasPagePool::PageRef> pages;
+	for( size_t i = 0; i < packers.size(); ++i ) {
+		AtlasPagePool::PageRef page = std::make_shared<AtlasPagePool::Page>( pageSize, tileSpacing, mSingleChannel );
+		page->mPacker = packers[i];
+		if( i < mPages.size() ) {
+			page->mTexture = mPages[i]->mTexture;
+		}
+		pages.push_back( page );
+	}
 
-	//! Base scale that SDF generator uses is size 32 at 72 DPI. A scale of 1.5, 2.0, and 3.0 translates to size 48, 64 and 96 and 72 DPI.
-	vec2						mSdfScale = vec2( 1.0f );
-	vec2						mSdfPadding = vec2( 2.0f );
-	ivec2						mSdfBitmapSize = ivec2( 0 );
-	vec2						mMaxGlyphSize = vec2( 0.0f );
-	float						mMaxAscent = 0.0f;
-	float						mMaxDescent = 0.0f;
-};
+	// Copy the glyphs that stay, the new ones are rendered
+	std::vector<RenderGlyph> newGlyphs;
+	for( const auto& placedGlyph : placedGlyphs ) {
+		if( newGlyphIndices.end() != newGlyphIndices.find( placedGlyph.glyphIndex ) ) {
+			newGlyphs.push_back( placedGlyph );
+			continue;
+		}
 
-SdfText::TextureAtlas::TextureAtlas()
-{
+		SdfText::Font::GlyphInfo& glyphInfo = mGlyphInfo[placedGlyph.glyphIndex];
+		const Area srcArea = glyphInfo.mTexCoords;
+		pages[placedGlyph.pageIndex]->mBitmap.copyFrom( mPages[glyphInfo.mTextureIndex]->mBitmap, srcArea, placedGlyph.position - srcArea.getUL() );
+		glyphInfo.mTextureIndex = static_cast<uint32_t>( placedGlyph.pageIndex );
+		glyphInfo.mTexCoords = Area( 0, 0, placedGlyph.size.x, placedGlyph.size.y ) + placedGlyph.position;
+	}
+
+	mPages = pages;
+	fillGlyphs( glyphOutlines, invertSdf, format, newGlyphs, renderedGlyphs );
+	uploadPages( placedGlyphs, true );
 }
 
-SdfText::TextureAtlas::TextureAtlas( FT_Face face, const SdfText::Format &format, const std::vector<SdfText::Font::Glyph> &glyphIndices )
-	: mFace( face ), mSdfScale( format.getSdfScale() ), mSdfPadding( format.getSdfPadding() )
+uint32_t SdfText::TextureAtlas::renderGlyph( const SdfText::Format &format, bool invertSdf, const RenderJob &job, AtlasBitmap &bitmap ) const
 {
-	const ivec2& tileSpacing = format.getSdfTileSpacing();
+	const double sdfRange = static_cast<double>( format.getSdfRange() );
+	const double sdfAngle = static_cast<double>( format.getSdfAngle() );
 
-	// CW (TTF) vs CCW (OTF) - SDF needs to be inverted if font is OTF
-	bool invertSdf = ( std::string( "OTTO" ) ==  std::string( reinterpret_cast<const char *>( face->stream->base ) ) );
+	// The cached outline is shared, the copy is simplified, normalized and colored
+	msdfgen::Shape shape = job.outline->mShape;
 
-	// Build glyph information that will be needed later
-	for( const auto& glyphIndex : glyphIndices ) {
-		// Glyph bounds, 
-		msdfgen::Shape shape;
-		if( msdfgen::loadGlyph( shape, face, glyphIndex ) ) {
-			double l, b, r, t;
-			l = b = r = t = 0.0;
-			shape.bounds( l, b, r, t );
-			// Glyph bounds
-			Rectf bounds = Rectf( 
-				static_cast<float>( l ), 
-				static_cast<float>( b ), 
-				static_cast<float>( r ), 
-				static_cast<float>( t ) );
-			mGlyphInfo[glyphIndex].mOriginOffset = vec2( l, b );
-			mGlyphInfo[glyphIndex].mSize = vec2( r - l, t - b );
-			// Max glyph size
-			mMaxGlyphSize.x = std::max( mMaxGlyphSize.x, bounds.getWidth() );
-			mMaxGlyphSize.y = std::max( mMaxGlyphSize.y, bounds.getHeight() );
-			// Max ascent, descent
-			mMaxAscent = std::max( mMaxAscent, static_cast<float>( t ) );
-			mMaxDescent = std::max( mMaxAscent, static_cast<float>( std::fabs( b ) ) );
-			//CI_LOG_I( (char)ch << " : " << mGlyphInfo[glyphIndex].mOriginOffset );
-		}	
+	// Tolerances are converted from texels to glyph units
+	const float maxScale = std::max( mSdfScale.x, mSdfScale.y );
+	shape.inverseYAxis = true;
+	if( format.getCubicTolerance() > 0.0f ) {
+		shape.approximateCubics( static_cast<double>( format.getCubicTolerance() / maxScale ), format.isCubicsToLines() );
 	}
-
-	// Determine render bitmap size
-	mSdfBitmapSize = SdfText::TextureAtlas::calculateSdfBitmapSize( mSdfScale, mSdfPadding, mMaxGlyphSize );
-	// Determine glyph counts (per texture atlas)
-	const size_t numGlyphColumns   = ( format.getTextureWidth()  / ( mSdfBitmapSize.x + tileSpacing.x ) );
-	const size_t numGlyphRows      = ( format.getTextureHeight() / ( mSdfBitmapSize.y + tileSpacing.y ) );
-	const size_t numGlyphsPerAtlas = numGlyphColumns * numGlyphRows;
-	
-	// Render position for each glyph
-	struct RenderGlyph {
-		uint32_t glyphIndex;
-		ivec2    position;
-	};
-
-	std::vector<std::vector<RenderGlyph>> renderAtlases;
-
-	// Build the atlases
-	size_t curRenderIndex = 0;
-	ivec2 curRenderPos = ivec2( 0 );
-	std::vector<RenderGlyph> curRenderGlyphs;
-	for( std::vector<SdfText::Font::Glyph>::const_iterator glyphIndexIt = glyphIndices.begin(); glyphIndexIt != glyphIndices.end() ;  ) {
-		// Build render glyph
-		RenderGlyph renderGlyph;
-		renderGlyph.glyphIndex = *glyphIndexIt;
-		renderGlyph.position.x = curRenderPos.x;
-		renderGlyph.position.y = curRenderPos.y;
-		
-		// Add to render atlas
-		curRenderGlyphs.push_back( renderGlyph );
-
-		// Increment index
-		++curRenderIndex;
-		// Increment glyph index iterator
-		++glyphIndexIt;
-		// Advance horizontal position
-		curRenderPos.x += mSdfBitmapSize.x;
-		curRenderPos.x += tileSpacing.x;
-		// Move to next row if needed
-		if( 0 == ( curRenderIndex % numGlyphColumns ) ) {
-			curRenderPos.x = 0;
-			curRenderPos.y += mSdfBitmapSize.y;
-			curRenderPos.y += tileSpacing.y;
-		}
-
-		if( ( numGlyphsPerAtlas == curRenderIndex ) || ( glyphIndices.end() == glyphIndexIt ) ) {
-			// Copy current atlas
-			renderAtlases.push_back( curRenderGlyphs );
-			// Reset values
-			curRenderIndex = 0;
-			curRenderPos = ivec2( 0 );
-			curRenderGlyphs.clear();
-		}
-	}
-
-	// Surface
-	Surface8u surface( format.getTextureWidth(), format.getTextureHeight(), false );
-	ip::fill( &surface, Color8u( 0, 0, 0 ) );
-	uint8_t *surfaceData   = surface.getData();
-	size_t surfacePixelInc = surface.getPixelInc();
-	size_t surfaceRowBytes = surface.getRowBytes();
-
-	// Render the atlases
-	const double sdfRange = static_cast<double>( format.getSdfRange() );
-	const double sdfAngle = static_cast<double>( format.getSdfAngle() );
-	msdfgen::Bitmap<msdfgen::FloatRGB> sdfBitmap( mSdfBitmapSize.x, mSdfBitmapSize.y );
-	uint32_t currentTextureIndex = 0;
-	for( size_t atlasIndex = 0; atlasIndex < renderAtlases.size(); ++atlasIndex ) {
-		const auto& renderGlyphs = renderAtlases[atlasIndex];
-		// Render atlas
-		for( const auto& renderGlyph : renderGlyphs ) {
-			msdfgen::Shape shape;
-			if( msdfgen::loadGlyph( shape, face, renderGlyph.glyphIndex ) ) {
-				shape.inverseYAxis = true;
-				shape.normalize();	
+	uint32_t simplifiedEdges = 0;
+	if( format.getSimplifyTolerance() > 0.0f ) {
+		simplifiedEdges = static_cast<uint32_t>( shape.simplify( static_cast<double>( format.getSimplifyTolerance() / maxScale ) ) );
+	}
+	shape.normalize();	
 				
-				// Edge color
-				msdfgen::edgeColoringSimple( shape, sdfAngle );
-
-				// Generate SDF
-				vec2 originOffset = mGlyphInfo[renderGlyph.glyphIndex].mOriginOffset;
-				float tx = mSdfPadding.x;
-				float ty = std::fabs( originOffset.y ) + mSdfPadding.y;
-				// mSdfScale will get applied to <tx, ty> by msdfgen
-				msdfgen::generateMSDF( sdfBitmap, shape, sdfRange, msdfgen::Vector2( mSdfScale.x, mSdfScale.y ), msdfgen::Vector2( tx, ty ) );
-
-				// Invert the SDF if needed, but only for glyphs that have contours to render. 
-				// Glyph without contours will produce and blank bitmap, inverting this produces
-				// a solid block. Which is undesirable.
-				if( invertSdf && ( ! shape.contours.empty() ) ) {
-					for( int y = 0; y < sdfBitmap.height(); ++y ) {
-						for( int x = 0; x < sdfBitmap.width(); ++x ) {
-							sdfBitmap( x, y ).r = 1.0f - sdfBitmap( x, y ).r;
-							sdfBitmap( x, y ).g = 1.0f - sdfBitmap( x, y ).g;
-							sdfBitmap( x, y ).b = 1.0f - sdfBitmap( x, y ).b;
-						}
-					}
-				}
+	// Edge color, single-channel fields do not use it
+	const bool singleChannel = format.isSingleChannel() || format.isDistanceTransform();
+	if( ! singleChannel ) {
+		msdfgen::edgeColoringSimple( shape, sdfAngle );
+	}
 
-				// Copy bitmap
-				size_t dstOffset = ( renderGlyph.position.y * surfaceRowBytes ) + ( renderGlyph.position.x * surfacePixelInc );
-				uint8_t *dst = surfaceData + dstOffset;
-				for( int n = 0; n < mSdfBitmapSize.y; ++n ) {
-					Color8u *dstPixel = reinterpret_cast<Color8u *>( dst );
-					for( int m = 0; m < mSdfBitmapSize.x; ++m ) {
-						msdfgen::FloatRGB &src = sdfBitmap( m, n );
-						Color srcPixel = Color( src.r, src.g, src.b );
-						*dstPixel = srcPixel;
-						++dstPixel;
-					}
-					dst += surfaceRowBytes;
-				}
+	// Invert the SDF if needed, but only for glyphs that have contours to render. 
+	// Glyph without contours will produce and blank bitmap, inverting this produces
+	// a solid block. Which is undesirable.
+	const bool invert = invertSdf && ( ! shape.contours.empty() );
+
+	// The distance field is generated directly into the glyph's cell, msdfgen clamps and quantizes 
+	// each pixel the same way converting Color to Color8u does.
+	uint8_t *cellData   = bitmap.getData( job.position );
+	size_t cellPixelInc = bitmap.getPixelInc();
+	size_t cellRowBytes = bitmap.getRowBytes();
+	msdfgen::ByteBitmapRef dst( cellData, job.size.x, job.size.y, static_cast<int>( cellPixelInc ), static_cast<int>( cellRowBytes ), invert );
+
+	// Generate SDF
+	float tx = mSdfPadding.x;
+	float ty = std::fabs( job.originOffset.y ) + mSdfPadding.y;
+	// mSdfScale will get applied to <tx, ty> by msdfgen
+	const double edgeThreshold = 1.00000001;
+	msdfgen::GeneratorConfig config( nullptr, true, format.isBandLimited(), format.isAdaptive() );
+	if( singleChannel ) {
+		// The distance transform is only used when it's asked for, single-channel pages otherwise get the exact pseudo-distance
+		if( format.isDistanceTransform() && ( ! format.isMaxQuality() ) ) {
+			msdfgen::generateDistanceTransformSDF( dst, shape, sdfRange, msdfgen::Vector2( mSdfScale.x, mSdfScale.y ), msdfgen::Vector2( tx, ty ) );
+		}
+		else if( format.isSinglePrecision() ) {
+			msdfgen::generatePseudoSDF( dst, msdfgen::CompiledShapef( shape ), sdfRange, msdfgen::Vector2( mSdfScale.x, mSdfScale.y ), msdfgen::Vector2( tx, ty ), config );
+		}
+		else {
+			msdfgen::generatePseudoSDF( dst, shape, sdfRange, msdfgen::Vector2( mSdfScale.x, mSdfScale.y ), msdfgen::Vector2( tx, ty ), config );
+		}
 
-				// Tex coords
-				mGlyphInfo[renderGlyph.glyphIndex].mTextureIndex = currentTextureIndex;
-				mGlyphInfo[renderGlyph.glyphIndex].mTexCoords = Area( 0, 0, mSdfBitmapSize.x, mSdfBitmapSize.y ) + renderGlyph.position;
+		// Replicate the field to the other channels of RGB pages, so that the median in the shader returns it unchanged
+		for( int y = 0; ( ! bitmap.isSingleChannel() ) && ( y < job.size.y ); ++y ) {
+			uint8_t *pixel = cellData + y * cellRowBytes;
+			for( int x = 0; x < job.size.x; ++x, pixel += cellPixelInc ) {
+				pixel[1] = pixel[0];
+				pixel[2] = pixel[0];
 			}
 		}
-		// Create texture
-		gl::TextureRef tex = gl::Texture::create( surface );
-		mTextures.push_back( tex );
-		++currentTextureIndex;
+	}
+	else if( format.isSinglePrecision() ) {
+		msdfgen::generateMSDF( dst, msdfgen::CompiledShapef( shape ), sdfRange, msdfgen::Vector2( mSdfScale.x, mSdfScale.y ), msdfgen::Vector2( tx, ty ), edgeThreshold, config );
+	}
+	else {
+		msdfgen::generateMSDF( dst, shape, sdfRange, msdfgen::Vector2( mSdfScale.x, mSdfScale.y ), msdfgen::Vector2( tx, ty ), edgeThreshold, config );
+	}
 
-		// Debug output
-		//writeImage( "sdfText_" + std::to_string( atlasIndex ) + ".png", surface );
+	return simplifiedEdges;
+}
+
+SdfText::TextureAtlasRef SdfText::TextureAtlas::create( FT_Face face, GlyphOutlineCache &outlines, const SdfText::Format &format, const std::vector<SdfText::Font::Glyph> &glyphIndices, AtlasPagePool *pagePool )
+{
+	// CW (TTF) vs CCW (OTF) - SDF needs to be inverted if font is OTF
+	bool invertSdf = SdfText::TextureAtlas::isInvertedSdf( face );
 
-		// Reset
-		ip::fill( &surface, Color8u( 0, 0, 0 ) );		
+	// The outlines are kept for rendering
+	OutlineMap glyphOutlines;
+	for( const auto& glyphIndex : glyphIndices ) {
+		glyphOutlines[glyphIndex] = outlines.get( face, glyphIndex );
 	}
+
+	return SdfText::TextureAtlas::create( glyphOutlines, invertSdf, format, glyphIndices, pagePool );
 }
 
-SdfText::TextureAtlasRef SdfText::TextureAtlas::create( FT_Face face, const SdfText::Format &format, const std::vector<SdfText::Font::Glyph> &glyphIndices )
+SdfText::TextureAtlasRef SdfText::TextureAtlas::create( const OutlineMap &glyphOutlines, bool invertSdf, const SdfText::Format &format, const std::vector<SdfText::Font::Glyph> &glyphIndices, AtlasPagePool *pagePool, bool growable )
 {
-	SdfText::TextureAtlasRef result = SdfText::TextureAtlasRef( new SdfText::TextureAtlas( face, format, glyphIndices ) );
+	SdfText::TextureAtlasRef result = SdfText::TextureAtlasRef( new SdfText::TextureAtlas( glyphOutlines, invertSdf, format, glyphIndices, pagePool, growable ) );
 	return result;
 }
 
+bool SdfText::TextureAtlas::isInvertedSdf( FT_Face face )
+{
+	return ( std::string( "OTTO" ) ==  std::string( reinterpret_cast<const char *>( face->stream->base ) ) );
+}
+
 cinder::ivec2 SdfText::TextureAtlas::calculateSdfBitmapSize( const vec2 &sdfScale, const ivec2& sdfPadding, const vec2 &maxGlyphSize )
 {
 	ivec2 result = ivec2( ( sdfScale * ( maxGlyphSize + ( 2.0f * vec2( sdfPadding ) ) ) ) + vec2( 0.5f ) );
 	return result;
 }
 
+size_t SdfText::TextureAtlas::calculateThreadCount( uint32_t threadCount, size_t numJobs )
+{
+	size_t result = ( threadCount > 0 ) ? static_cast<size_t>( threadCount ) : static_cast<size_t>( std::thread::hardware_concurrency() );
+	result = std::min( result, numJobs );
+	result = std::max<size_t>( result, 1 );
+	return result;
+}
+
 // =================================================================================================
 // SdfTextManager
 // =================================================================================================
@@ -487,6 +1776,8 @@ private:
 	mutable SdfText::Font			mDefault;
 
 	SdfText::TextureAtlas::AtlasCacher		mTrackedTextureAtlases;
+	GlyphOutlineCache						mOutlineCache;
+	AtlasPagePool							mPagePool;
 
 	void							acquireFontNamesAndPaths();
 	void							faceCreated( FT_Face face );
@@ -885,10 +2176,16 @@ void SdfTextManager::faceCreated( FT_Face face )
 void SdfTextManager::faceDestroyed( FT_Face face ) 
 {
 	mTrackedFaces.erase( face );
+	mOutlineCache.evict( face );
 }
 
 SdfText::TextureAtlasRef SdfTextManager::getTextureAtlas( FT_Face face, const SdfText::Format &format, const std::string &utf8Chars, const std::vector<SdfText::Font::Glyph> &glyphIndices )
 {
+	// Dynamic atlases change as they're drawn, so every SdfText gets its own
+	if( format.isDynamic() ) {
+		return SdfText::TextureAtlas::create( face, mOutlineCache, format, glyphIndices );
+	}
+
 	std::u32string utf32Chars = ci::toUtf32( utf8Chars );
 	// Add a space if needed
 	if( std::string::npos == utf8Chars.find( ' ' ) ) {
@@ -900,17 +2197,14 @@ SdfText::TextureAtlasRef SdfTextManager::getTextureAtlas( FT_Face face, const Sd
 	for( const auto& ch : utf32Chars ) {
 		FT_UInt glyphIndex = FT_Get_Char_Index( face, static_cast<FT_ULong>( ch ) );
 		// Glyph bounds, 
-		msdfgen::Shape shape;
-		if( msdfgen::loadGlyph( shape, face, glyphIndex ) ) {
-			double l, b, r, t;
-			l = b = r = t = 0.0;
-			shape.bounds( l, b, r, t );
+		GlyphOutlineCache::OutlineRef outline = mOutlineCache.get( face, glyphIndex );
+		if( outline->mLoaded ) {
 			// Glyph bounds
 			Rectf bounds = Rectf( 
-				static_cast<float>( l ), 
-				static_cast<float>( b ), 
-				static_cast<float>( r ), 
-				static_cast<float>( t ) );
+				static_cast<float>( outline->mLeft ), 
+				static_cast<float>( outline->mBottom ), 
+				static_cast<float>( outline->mRight ), 
+				static_cast<float>( outline->mTop ) );
 			// Max glyph size
 			maxGlyphSize.x = std::max( maxGlyphSize.x, bounds.getWidth() );
 			maxGlyphSize.y = std::max( maxGlyphSize.y, bounds.getHeight() );
@@ -923,6 +2217,20 @@ SdfText::TextureAtlasRef SdfTextManager::getTextureAtlas( FT_Face face, const Sd
 	key.mUtf8Chars = utf8Chars;
 	key.mTextureSize = format.getTextureSize();
 	key.mSdfBitmapSize = SdfText::TextureAtlas::calculateSdfBitmapSize( format.getSdfScale(), format.getSdfPadding(), maxGlyphSize );
+	key.mSdfScale = format.getSdfScale();
+	key.mSdfRange = format.getSdfRange();
+	key.mSdfAngle = format.getSdfAngle();
+	key.mTileSpacing = format.getSdfTileSpacing();
+	key.mSharedPages = format.isSharedPages();
+	key.mSinglePrecision = format.isSinglePrecision();
+	key.mCubicTolerance = format.getCubicTolerance();
+	key.mCubicsToLines = format.isCubicsToLines();
+	key.mSimplifyTolerance = format.getSimplifyTolerance();
+	key.mBandLimited = format.isBandLimited();
+	key.mAdaptive = format.isAdaptive();
+	key.mDistanceTransform = format.isDistanceTransform();
+	key.mMaxQuality = format.isMaxQuality();
+	key.mSingleChannel = format.isSingleChannel();
 
 	// Result
 	SdfText::TextureAtlasRef result;
@@ -938,7 +2246,7 @@ SdfText::TextureAtlasRef SdfTextManager::getTextureAtlas( FT_Face face, const Sd
 	}
 	// ...otherwise build a new one
 	else {
-		result = SdfText::TextureAtlas::create( face, format, glyphIndices );
+		result = SdfText::TextureAtlas::create( face, mOutlineCache, format, glyphIndices, format.isSharedPages() ? &mPagePool : nullptr );
 		mTrackedTextureAtlases.push_back( std::make_pair( key, result ) );
 	}
 
@@ -1177,6 +2485,9 @@ struct LineMeasure
 
 std::vector<std::string> SdfTextBox::calculateLineBreaks() const
 {
+	// Dynamic formats look up the characters that are missing before they're measured
+	mSdfText->requestChars( mText );
+
 	const auto& charToGlyph = mSdfText->getCharToGlyph();
 	const auto& glyphMetrics = mSdfText->getGlyphMetrics();
 
@@ -1484,83 +2795,265 @@ FT_Face SdfText::Font::getFace() const
 	return mData->getFace();
 }
 
-const std::vector<std::string>& SdfText::Font::getNames( bool forceRefresh )
+const std::vector<std::string>& SdfText::Font::getNames( bool forceRefresh )
+{
+	return SdfTextManager::instance()->getNames( forceRefresh );
+}
+
+SdfText::Font SdfText::Font::getDefault()
+{
+	return SdfTextManager::instance()->getDefault();
+}
+
+// =================================================================================================
+// SdfText
+// =================================================================================================
+SdfText::SdfText( const SdfText::Font &font, const Format &format, const std::string &utf8Chars, bool generateSdf )
+	: mFont( font ), mFormat( format )
+{
+	if( generateSdf ) {
+		FT_Face face = font.getFace();
+		if( nullptr == face ) {
+			throw std::runtime_error( "null font face" );
+		}
+
+		// Build char/glyph maps
+		std::vector<SdfText::Font::Glyph> glyphIndices = mapChars( utf8Chars );
+
+		// Get texture atlas - will build if necessary
+		mTextureAtlases = SdfTextManager::instance()->getTextureAtlas( face, format, utf8Chars, glyphIndices );
+
+		// Build glyph metrics
+		{
+			FT_Face face = mFont.getFace();
+			GlyphOutlineCache &outlines = SdfTextManager::instance()->mOutlineCache;
+			for( const auto &glyphIndex : glyphIndices ) {
+				mGlyphMetrics[glyphIndex] = outlines.get( face, glyphIndex )->mMetrics;
+			}
+		}
+	}
+}
+
+SdfText::~SdfText()
+{
+}
+
+SdfTextRef SdfText::create( const SdfText::Font &font, const Format &format, const std::string &supportedChars )
+{
+	SdfTextRef result = SdfTextRef( new SdfText( font, format, supportedChars ) );
+	return result;
+}
+
+SdfText::AsyncHandleRef SdfText::createAsync( const SdfText::Font &font, const Format &format, const std::string &utf8Chars, const std::string &priorityChars )
+{
+	FT_Face face = font.getFace();
+	if( nullptr == face ) {
+		throw std::runtime_error( "null font face" );
+	}
+
+	// The atlas is built here rather than by the manager, it grows as the glyphs are generated so it 
+	// can't be cached or share pages
+	SdfTextRef sdfText = SdfTextRef( new SdfText( font, format, "", false ) );
+	std::vector<SdfText::Font::Glyph> priorityGlyphs = sdfText->mapChars( priorityChars );
+	std::vector<SdfText::Font::Glyph> remainingGlyphs;
+	for( const auto &glyphIndex : sdfText->mapChars( utf8Chars ) ) {
+		if( std::end( priorityGlyphs ) == std::find( std::begin( priorityGlyphs ), std::end( priorityGlyphs ), glyphIndex ) ) {
+			remainingGlyphs.push_back( glyphIndex );
+		}
+	}
+
+	// Outlines and metrics of every glyph are loaded up front, so that layout doesn't wait for the 
+	// glyphs and the background thread doesn't touch FreeType
+	GlyphOutlineCache &outlines = SdfTextManager::instance()->mOutlineCache;
+	SdfText::TextureAtlas::OutlineMap priorityOutlines;
+	for( const auto &glyphIndex : priorityGlyphs ) {
+		priorityOutlines[glyphIndex] = outlines.get( face, glyphIndex );
+		sdfText->mGlyphMetrics[glyphIndex] = priorityOutlines[glyphIndex]->mMetrics;
+	}
+	SdfText::TextureAtlas::OutlineMap remainingOutlines;
+	for( const auto &glyphIndex : remainingGlyphs ) {
+		remainingOutlines[glyphIndex] = outlines.get( face, glyphIndex );
+		sdfText->mGlyphMetrics[glyphIndex] = remainingOutlines[glyphIndex]->mMetrics;
+	}
+
+	const bool invertSdf = SdfText::TextureAtlas::isInvertedSdf( face );
+	const SdfText::Format atlasFormat = SdfText::Format( format ).dynamic( false );
+	sdfText->mTextureAtlases = SdfText::TextureAtlas::create( priorityOutlines, invertSdf, atlasFormat, priorityGlyphs, nullptr, true );
+	sdfText->mTextureAtlases->startAsync( remainingOutlines, invertSdf, atlasFormat, remainingGlyphs );
+	sdfText->mTextureAtlases->mAsync->mNumResident = priorityGlyphs.size();
+
+	SdfText::AsyncHandleRef result = SdfText::AsyncHandleRef( new SdfText::AsyncHandle( sdfText ) );
+	return result;
+}
+
+std::vector<SdfText::Font::Glyph> SdfText::mapChars( const std::string &utf8Chars )
+{
+	FT_Face face = mFont.getFace();
+
+	// Convert characters from UTF8 to UTF32
+	std::u32string utf32Chars = ci::toUtf32( utf8Chars );
+	// Add a space if needed
+	if( std::string::npos == utf8Chars.find( ' ' ) ) {
+		utf32Chars += ci::toUtf32( " " );
+	}
+
+	// Build char/glyph maps
+	std::vector<SdfText::Font::Glyph> glyphIndices;
+	for( const auto &ch : utf32Chars ) {
+		// Lookup glyph index based on char
+		SdfText::Font::Glyph glyphIndex = static_cast<SdfText::Font::Glyph>( FT_Get_Char_Index( face, static_cast<FT_ULong>( ch ) ) );
+
+		// Unique glyph
+		auto it = std::find_if( std::begin( glyphIndices ), std::end( glyphIndices ),
+			[glyphIndex]( const SdfText::Font::Glyph &elem ) -> bool {
+				return ( elem == glyphIndex );
+			}
+		);
+		if( std::end( glyphIndices ) == it ) {
+			glyphIndices.push_back( glyphIndex );
+		}
+
+		// Character to glyph index and vice versa
+		mCharToGlyph[static_cast<SdfText::Font::Char>( ch )] = glyphIndex;
+		mGlyphToChar[glyphIndex] = static_cast<SdfText::Font::Char>( ch );
+	}
+
+	return glyphIndices;
+}
+
+void SdfText::requestChars( const std::string &utf8Chars ) const
+{
+	if( ( ! mTextureAtlases ) || ( ! mTextureAtlases->mDynamic ) ) {
+		return;
+	}
+
+	FT_Face face = mFont.getFace();
+	GlyphOutlineCache &outlines = SdfTextManager::instance()->mOutlineCache;
+	std::u32string utf32Chars = ci::toUtf32( utf8Chars );
+	for( const auto &ch : utf32Chars ) {
+		SdfText::Font::Glyph glyphIndex = 0;
+		auto glyphIndexIt = mCharToGlyph.find( static_cast<SdfText::Font::Char>( ch ) );
+		if( mCharToGlyph.end() != glyphIndexIt ) {
+			glyphIndex = glyphIndexIt->second;
+		}
+		else {
+			// Layout needs the metrics right away, the glyph itself can wait for the next draw
+			glyphIndex = static_cast<SdfText::Font::Glyph>( FT_Get_Char_Index( face, static_cast<FT_ULong>( ch ) ) );
+			mCharToGlyph[static_cast<SdfText::Font::Char>( ch )] = glyphIndex;
+			mGlyphToChar[glyphIndex] = static_cast<SdfText::Font::Char>( ch );
+			mGlyphMetrics[glyphIndex] = outlines.get( face, glyphIndex )->mMetrics;
+		}
+
+		requestGlyph( glyphIndex );
+	}
+}
+
+void SdfText::requestGlyph( SdfText::Font::Glyph glyph ) const
+{
+	TextureAtlas &atlas = *mTextureAtlases;
+	if( ( atlas.mGlyphInfo.end() != atlas.mGlyphInfo.find( glyph ) ) || ( atlas.mPendingGlyphs.end() != atlas.mPendingGlyphs.find( glyph ) ) ) {
+		return;
+	}
+
+	// Glyphs that can't be loaded would be requested over and over
+	if( SdfTextManager::instance()->mOutlineCache.get( mFont.getFace(), glyph )->mLoaded ) {
+		atlas.mPendingGlyphs.insert( glyph );
+	}
+}
+
+void SdfText::updateGlyphs( const SdfText::Font::GlyphMeasuresList &glyphMeasures )
+{
+	if( ! mTextureAtlases ) {
+		return;
+	}
+
+	// Glyphs that createAsync finished since the last draw
+	TextureAtlas &atlas = *mTextureAtlases;
+	atlas.updateAsync();
+
+	if( ! atlas.mDynamic ) {
+		return;
+	}
+
+	// The glyphs being drawn are stamped so that they're evicted last, glyphs that were placed 
+	// without laying out text through this SdfText are requested here
+	++atlas.mDrawStamp;
+	for( const auto &glyphMeasure : glyphMeasures ) {
+		atlas.mLastDrawn[glyphMeasure.first] = atlas.mDrawStamp;
+		requestGlyph( glyphMeasure.first );
+	}
+
+	if( atlas.mPendingGlyphs.empty() ) {
+		return;
+	}
+
+	// Everything that was requested since the last draw is generated in one batch
+	FT_Face face = mFont.getFace();
+	GlyphOutlineCache &outlines = SdfTextManager::instance()->mOutlineCache;
+	std::vector<SdfText::Font::Glyph> glyphIndices( atlas.mPendingGlyphs.begin(), atlas.mPendingGlyphs.end() );
+	SdfText::TextureAtlas::OutlineMap glyphOutlines;
+	for( const auto &glyphIndex : glyphIndices ) {
+		glyphOutlines[glyphIndex] = outlines.get( face, glyphIndex );
+	}
+	atlas.mPendingGlyphs.clear();
+
+	atlas.addGlyphs( glyphOutlines, SdfText::TextureAtlas::isInvertedSdf( face ), mFormat, glyphIndices );
+}
+
+float SdfText::AsyncHandle::getProgress() const
+{
+	const SdfText::TextureAtlasRef& atlas = mSdfText->mTextureAtlases;
+	if( ( ! atlas ) || ( ! atlas->mAsync ) ) {
+		return 1.0f;
+	}
+
+	const auto& async = *atlas->mAsync;
+	const size_t total = async.mNumResident + async.mGlyphIndices.size();
+	float result = ( total > 0 ) ? static_cast<float>( async.mNumResident + async.mNumUploaded ) / static_cast<float>( total ) : 1.0f;
+	return result;
+}
+
+bool SdfText::AsyncHandle::isDone() const
+{
+	const SdfText::TextureAtlasRef& atlas = mSdfText->mTextureAtlases;
+	if( ( ! atlas ) || ( ! atlas->mAsync ) ) {
+		return true;
+	}
+
+	bool result = atlas->mAsync->mCanceled || ( atlas->mAsync->mNumUploaded >= atlas->mAsync->mGlyphIndices.size() );
+	return result;
+}
+
+void SdfText::AsyncHandle::cancel()
 {
-	return SdfTextManager::instance()->getNames( forceRefresh );
+	const SdfText::TextureAtlasRef& atlas = mSdfText->mTextureAtlases;
+	if( atlas && atlas->mAsync ) {
+		atlas->mAsync->mCanceled = true;
+	}
 }
 
-SdfText::Font SdfText::Font::getDefault()
+bool SdfText::AsyncHandle::isCanceled() const
 {
-	return SdfTextManager::instance()->getDefault();
+	const SdfText::TextureAtlasRef& atlas = mSdfText->mTextureAtlases;
+	bool result = atlas && atlas->mAsync && atlas->mAsync->mCanceled;
+	return result;
 }
 
-// =================================================================================================
-// SdfText
-// =================================================================================================
-SdfText::SdfText( const SdfText::Font &font, const Format &format, const std::string &utf8Chars, bool generateSdf )
-	: mFont( font ), mFormat( format )
+void SdfText::AsyncHandle::update()
 {
-	if( generateSdf ) {
-		FT_Face face = font.getFace();
-		if( nullptr == face ) {
-			throw std::runtime_error( "null font face" );
-		}
-
-		// Convert characters from UTF8 to UTF32
-		std::u32string utf32Chars = ci::toUtf32( utf8Chars );
-		// Add a space if needed
-		if( std::string::npos == utf8Chars.find( ' ' ) ) {
-			utf32Chars += ci::toUtf32( " " );
-		}
-
-		// Build char/glyph maps
-		std::vector<SdfText::Font::Glyph> glyphIndices;
-		for( const auto &ch : utf32Chars ) {
-			// Lookup glyph index based on char
-			SdfText::Font::Glyph glyphIndex = static_cast<SdfText::Font::Glyph>( FT_Get_Char_Index( face, static_cast<FT_ULong>( ch ) ) );
-
-			// Unique glyph
-			auto it = std::find_if( std::begin( glyphIndices ), std::end( glyphIndices ),
-				[glyphIndex]( const SdfText::Font::Glyph &elem ) -> bool {
-					return ( elem == glyphIndex );
-				}
-			);
-			if( std::end( glyphIndices ) == it ) {
-				glyphIndices.push_back( glyphIndex );
-			}
-
-			// Character to glyph index and vice versa
-			mCharToGlyph[static_cast<SdfText::Font::Char>( ch )] = glyphIndex;
-			mGlyphToChar[glyphIndex] = static_cast<SdfText::Font::Char>( ch );
-		}
-
-		// Get texture atlas - will build if necessary
-		mTextureAtlases = SdfTextManager::instance()->getTextureAtlas( face, format, utf8Chars, glyphIndices );
-
-		// Build glyph metrics
-		{
-			FT_Face face = mFont.getFace();
-			for( const auto &glyphIndex : glyphIndices ) {
-				FT_Load_Glyph( face, glyphIndex, FT_LOAD_DEFAULT );
-				FT_GlyphSlot slot = face->glyph;
-				SdfText::Font::GlyphMetrics glyphMetrics;
-				glyphMetrics.advance = vec2( slot->linearHoriAdvance, slot->linearVertAdvance ) / 65536.0f;
-				glyphMetrics.minimum = vec2( slot->metrics.horiBearingX, slot->metrics.vertBearingY - slot->metrics.height ) / 65536.0f;
-				glyphMetrics.maximum = vec2( slot->metrics.horiBearingX + slot->metrics.width, slot->metrics.vertBearingY ) / 65536.0f;
-				mGlyphMetrics[glyphIndex] = glyphMetrics;
-			}
-		}
+	if( mSdfText->mTextureAtlases ) {
+		mSdfText->mTextureAtlases->updateAsync();
 	}
 }
 
-SdfText::~SdfText()
+void SdfText::setOutlineCacheBudget( size_t bytes )
 {
+	SdfTextManager::instance()->mOutlineCache.setBudget( bytes );
 }
 
-SdfTextRef SdfText::create( const SdfText::Font &font, const Format &format, const std::string &supportedChars )
+size_t SdfText::getOutlineCacheBudget()
 {
-	SdfTextRef result = SdfTextRef( new SdfText( font, format, supportedChars ) );
-	return result;
+	return SdfTextManager::instance()->mOutlineCache.getBudget();
 }
 
 cinder::gl::SdfTextRef SdfText::create( const fs::path& filePath, const SdfText::Font &font, const Format &format, const std::string &utf8Chars )
@@ -1583,7 +3076,8 @@ cinder::gl::SdfTextRef SdfText::create( const fs::path& filePath, const SdfText:
 
 void SdfText::save(const ci::DataTargetRef& target, const SdfTextRef& sdfText)
 {
-	const uint32_t kCurrentVersion = 0x00000001;
+	// Version 2 adds the single-channel flag to the texture atlases
+	const uint32_t kCurrentVersion = 0x00000002;
 
 	if( ! target ) {
 		throw ci::Exception( "Invalid data target" );
@@ -1695,6 +3189,8 @@ void SdfText::save(const ci::DataTargetRef& target, const SdfTextRef& sdfText)
 		os->writeLittle( sdfText->mTextureAtlases->mMaxAscent );
 		// Max descent
 		os->writeLittle( sdfText->mTextureAtlases->mMaxDescent );
+		// Single channel
+		os->writeLittle( static_cast<uint8_t>( sdfText->mTextureAtlases->mSingleChannel ? 1 : 0 ) );
 	
 		// Number of glyphs
 		const uint32_t numChars = static_cast<uint32_t>( sdfText->mTextureAtlases->mGlyphInfo.size() );
@@ -1881,6 +3377,12 @@ SdfTextRef SdfText::load( const ci::DataSourceRef& source, float size )
 		is->readLittle( &(textureAtlases->mMaxAscent) );
 		// Max descent
 		is->readLittle( &(textureAtlases->mMaxDescent) );
+		// Single channel, earlier versions are always three channels
+		if( version >= 0x00000002 ) {
+			uint8_t singleChannel = 0;
+			is->readLittle( &singleChannel );
+			textureAtlases->mSingleChannel = ( 0 != singleChannel );
+		}
 
 		// Number of glyphs
 		uint32_t numGlyphs = 0;
@@ -1918,9 +3420,9 @@ SdfTextRef SdfText::load( const ci::DataSourceRef& source, float size )
 			is->readLittle( &bufferSize );
 			BufferRef buffer = Buffer::create( bufferSize );
 			is->readData( buffer->getData(), buffer->getSize() );
-			// Create surface
+			// Create texture, single-channel atlases are loaded as R8
 			ImageSourceRef pngSource = loadImage( DataSourceBuffer::create( buffer ) );
-			gl::TextureRef tex = gl::Texture2d::create( pngSource );
+			gl::TextureRef tex = textureAtlases->mSingleChannel ? gl::Texture2d::create( Channel8u( pngSource ) ) : gl::Texture2d::create( pngSource );
 			// Add texture
 			textureAtlases->mTextures.push_back( tex );
 		}
@@ -1936,8 +3438,277 @@ SdfTextRef SdfText::load( const ci::fs::path& filePath, float size )
 	return SdfText::load( ci::DataSourcePath::create( filePath ), size );
 }
 
+void SdfText::saveOutlines( const ci::DataTargetRef& target, const SdfTextRef& sdfText )
+{
+	const uint32_t kCurrentVersion = 0x00000001;
+
+	if( ! target ) {
+		throw ci::Exception( "Invalid data target" );
+	}
+
+	auto os = target->getStream();
+	if( ! os ) {
+		throw ci::Exception( "Invalid out stream" );
+	}
+
+	FT_Face face = sdfText->getFont().getFace();
+	if( nullptr == face ) {
+		throw ci::Exception( "No font face" );
+	}
+
+	// File ident: SDFO
+	os->write( static_cast<uint8_t>( 'S' ) );
+	os->write( static_cast<uint8_t>( 'D' ) );
+	os->write( static_cast<uint8_t>( 'F' ) );
+	os->write( static_cast<uint8_t>( 'O' ) );
+
+	// Version
+	os->writeLittle( kCurrentVersion );
+
+	// Name
+	{
+		const std::string name = sdfText->getFont().getName();
+		const uint32_t nameLength = static_cast<uint32_t>( name.length() );
+		os->writeLittle( nameLength );
+		os->writeData( name.data(), nameLength );
+	}
+
+	// Size
+	os->writeLittle( sdfText->getFont().getSize() );
+	// Leading
+	os->writeLittle( sdfText->getFont().getLeading() );
+	// Height
+	os->writeLittle( sdfText->getFont().getHeight() );
+	// Ascent
+	os->writeLittle( sdfText->getFont().getAscent() );
+	// Descent
+	os->writeLittle( sdfText->getFont().getDescent() );
+	// Invert SDF
+	os->write( static_cast<uint8_t>( SdfText::TextureAtlas::isInvertedSdf( face ) ? 1 : 0 ) );
+
+	// Char/glyph maps
+	{
+		// Char/glyph ident: CHGL
+		os->write( static_cast<uint8_t>( 'C' ) );
+		os->write( static_cast<uint8_t>( 'H' ) );
+		os->write( static_cast<uint8_t>( 'G' ) );
+		os->write( static_cast<uint8_t>( 'L' ) );
+
+		// Number of chars
+		const uint32_t numChars = static_cast<uint32_t>( sdfText->mCharToGlyph.size() );
+		os->writeLittle( numChars );
+		// Chars/glyphs
+		for( const auto& it : sdfText->mCharToGlyph ) {
+			uint32_t ch = static_cast<uint32_t>( it.first );
+			const SdfText::Font::Glyph& glyph = it.second;
+			os->writeLittle( ch );
+			os->writeLittle( glyph );
+		}		
+	}
+
+	// Glyph metrics and outlines
+	{
+		// Glyph outlines ident: GLOL
+		os->write( static_cast<uint8_t>( 'G' ) );
+		os->write( static_cast<uint8_t>( 'L' ) );
+		os->write( static_cast<uint8_t>( 'O' ) );
+		os->write( static_cast<uint8_t>( 'L' ) );
+
+		// Number of glyphs
+		const uint32_t numGlyphs = static_cast<uint32_t>( sdfText->mGlyphMetrics.size() );
+		os->writeLittle( numGlyphs );
+		// Glyphs
+		GlyphOutlineCache &outlines = SdfTextManager::instance()->mOutlineCache;
+		for( const auto& it : sdfText->mGlyphMetrics ) {
+			const SdfText::Font::Glyph& glyph = it.first;
+			const SdfText::Font::GlyphMetrics& metrics = it.second;
+			os->writeLittle( glyph );
+			os->writeLittle( metrics.advance.x );
+			os->writeLittle( metrics.advance.y );
+			os->writeLittle( metrics.minimum.x );
+			os->writeLittle( metrics.minimum.y );
+			os->writeLittle( metrics.maximum.x );
+			os->writeLittle( metrics.maximum.y );
+
+			// Outline, in the units of the SDF generator and therefore independent of the font size
+			GlyphOutlineCache::OutlineRef outline = outlines.get( face, glyph );
+			os->write( static_cast<uint8_t>( outline->mLoaded ? 1 : 0 ) );
+			if( outline->mLoaded ) {
+				os->writeLittle( outline->mAdvance );
+				os->writeLittle( outline->mLeft );
+				os->writeLittle( outline->mBottom );
+				os->writeLittle( outline->mRight );
+				os->writeLittle( outline->mTop );
+				std::vector<unsigned char> shapeData;
+				if( ! msdfgen::writeShapeBinary( shapeData, outline->mShape ) ) {
+					throw ci::Exception( "Outline can't be encoded" );
+				}
+				os->writeLittle( static_cast<uint32_t>( shapeData.size() ) );
+				os->writeData( shapeData.data(), shapeData.size() );
+			}
+		}
+	}
+}
+
+void SdfText::saveOutlines( const ci::fs::path& filePath, const SdfTextRef& sdfText )
+{
+	SdfText::saveOutlines( ci::writeFile( filePath, true ), sdfText );
+}
+
+SdfTextRef SdfText::createFromOutlines( const ci::DataSourceRef& source, const Format &format, float size )
+{
+	ci::IStreamRef is = source->createStream();
+	if( ! is ) {
+		throw ci::Exception( "Invalid source" );
+	}
+	
+	// File ident: SDFO
+	{
+		uint8_t ident[4];
+		is->readData( ident, 4 );
+		if( std::string( "SDFO") != std::string( reinterpret_cast<const char*>( ident ), 4 ) ) {
+			throw ci::Exception( "Not a SDF text outline pack" );
+		}
+	}
+
+	// Version
+	uint32_t version = 0;
+	is->readLittle( &version );
+
+	// Font
+	SdfText::Font font;
+
+	// Name
+	{
+		uint32_t nameLength = 0;
+		is->readLittle( &nameLength );
+		std::vector<uint8_t> nameBuf( nameLength );
+		is->readData( nameBuf.data(), nameLength );
+		font.mName = std::string( reinterpret_cast<const char *>( nameBuf.data() ), nameBuf.size() );
+	}
+
+	// Size
+	is->readLittle( &(font.mSize) );
+	// Leading
+	is->readLittle( &(font.mLeading) );
+	// Height
+	is->readLittle( &(font.mHeight) );
+	// Ascent
+	is->readLittle( &(font.mAscent) );
+	// Descent
+	is->readLittle( &(font.mDescent) );
+	// Invert SDF
+	uint8_t invertSdf = 0;
+	is->readLittle( &invertSdf );
+
+	// Override font size if it's requested
+	float fontSizeScale = 1.0f;
+	if( size > 0.0f ) {
+		fontSizeScale = size / font.mSize;
+		font.mSize = size;
+	}
+
+	// Create SdfText
+	SdfTextRef sdfText = SdfTextRef( new SdfText( font, format, "", false ) );
+
+	// Char/glyph maps
+	{
+		// Char/glyph ident: CHGL
+		uint8_t ident[4];
+		is->readData( ident, 4 );
+		if( std::string( "CHGL") != std::string( reinterpret_cast<const char*>( ident ), 4 ) ) {
+			throw ci::Exception( "Char/glyph ident not found" );
+		}
+
+		// Number of chars
+		uint32_t numChars = 0;
+		is->readLittle( &numChars );
+		// Chars/glyphs
+		for( uint32_t i = 0; i < numChars; ++i ) {
+			uint32_t ch = 0;
+			SdfText::Font::Glyph glyph = 0;
+			is->readLittle( &ch );
+			is->readLittle( &glyph );
+			SdfText::Font::Char sdftCh = static_cast<SdfText::Font::Char>( ch );
+			sdfText->mCharToGlyph[sdftCh] = glyph;
+			sdfText->mGlyphToChar[glyph] = sdftCh;
+		}		
+	}
+
+	// Glyph metrics and outlines
+	std::vector<SdfText::Font::Glyph> glyphIndices;
+	SdfText::TextureAtlas::OutlineMap glyphOutlines;
+	{
+		// Glyph outlines ident: GLOL
+		uint8_t ident[4];
+		is->readData( ident, 4 );
+		if( std::string( "GLOL") != std::string( reinterpret_cast<const char*>( ident ), 4 ) ) {
+			throw ci::Exception( "Glyph outlines ident not found" );
+		}
+
+		// Number of glyphs
+		uint32_t numGlyphs = 0;
+		is->readLittle( &numGlyphs );
+		// Glyphs
+		for( uint32_t i = 0; i < numGlyphs; ++i ) {
+			SdfText::Font::Glyph glyph = 0;
+			SdfText::Font::GlyphMetrics metrics = {};
+			is->readLittle( &glyph );
+			is->readLittle( &(metrics.advance.x) );
+			is->readLittle( &(metrics.advance.y) );
+			is->readLittle( &( metrics.minimum.x ) );
+			is->readLittle( &( metrics.minimum.y ) );
+			is->readLittle( &( metrics.maximum.x ) );
+			is->readLittle( &( metrics.maximum.y ) );
+			metrics.advance *= fontSizeScale;
+			metrics.minimum *= fontSizeScale;
+			metrics.maximum *= fontSizeScale;
+			sdfText->mGlyphMetrics[glyph] = metrics;
+
+			// Outline
+			std::shared_ptr<GlyphOutlineCache::Outline> outline = std::make_shared<GlyphOutlineCache::Outline>();
+			uint8_t loaded = 0;
+			is->readLittle( &loaded );
+			if( 0 != loaded ) {
+				outline->mLoaded = true;
+				is->readLittle( &(outline->mAdvance) );
+				is->readLittle( &(outline->mLeft) );
+				is->readLittle( &(outline->mBottom) );
+				is->readLittle( &(outline->mRight) );
+				is->readLittle( &(outline->mTop) );
+				uint32_t shapeDataSize = 0;
+				is->readLittle( &shapeDataSize );
+				std::vector<unsigned char> shapeData( shapeDataSize );
+				is->readData( shapeData.data(), shapeData.size() );
+				if( shapeData.size() != msdfgen::readShapeBinary( shapeData.data(), shapeData.size(), outline->mShape ) ) {
+					throw ci::Exception( "Invalid glyph outline" );
+				}
+			}
+			outline->mMetrics = metrics;
+
+			glyphIndices.push_back( glyph );
+			glyphOutlines[glyph] = outline;
+		}
+	}
+
+	// Generate the atlases. They skip the manager's atlas cache since they're not tied to a face, but their pages can come from
+	// the shared page pool. They're never dynamic, since every glyph in the pack is generated up front and there's no face to 
+	// load missing glyphs from.
+	AtlasPagePool *pagePool = format.isSharedPages() ? &(SdfTextManager::instance()->mPagePool) : nullptr;
+	sdfText->mTextureAtlases = SdfText::TextureAtlas::create( glyphOutlines, ( 0 != invertSdf ), SdfText::Format( format ).dynamic( false ), glyphIndices, pagePool );
+
+	return sdfText;
+}
+
+SdfTextRef SdfText::createFromOutlines( const ci::fs::path& filePath, const Format &format, float size )
+{
+	return SdfText::createFromOutlines( ci::DataSourcePath::create( filePath ), format, size );
+}
+
 void SdfText::drawGlyphs( const SdfText::Font::GlyphMeasuresList &glyphMeasures, const vec2 &baselineIn, const DrawOptions &options, const std::vector<ColorA8u> &colors )
 {
+	updateGlyphs( glyphMeasures );
+
 	const auto& textures = mTextureAtlases->mTextures;
 	const auto& glyphMap = mTextureAtlases->mGlyphInfo;
 	const auto& sdfScale = mTextureAtlases->mSdfScale;
@@ -1954,7 +3725,7 @@ void SdfText::drawGlyphs( const SdfText::Font::GlyphMeasuresList &glyphMeasures,
 
 	auto shader = options.getGlslProg();
 	if( ! shader ) {
-		shader = SdfText::defaultShader();
+		shader = SdfText::defaultShader( isSingleChannel() );
 	}
 	ScopedTextureBind texBindScp( textures[0] );
 	ScopedGlslProg glslScp( shader );
@@ -2043,6 +3814,12 @@ void SdfText::drawGlyphs( const SdfText::Font::GlyphMeasuresList &glyphMeasures,
 		}
 		
 		curTex->bind();
+#if defined(CINDER_GL_ES)
+		// Pages are sized to their glyphs, so they can differ in size
+		if( ! options.getGlslProg() ) {
+			shader->uniform( "uTexSize", vec2( curTex->getSize() ) );
+		}
+#endif
 		auto ctx = gl::context();
 		size_t dataSize = (verts.size() + texCoords.size()) * sizeof(float) + vertColors.size() * sizeof(ColorA8u);
 		gl::ScopedVao vaoScp( ctx->getDefaultVao() );
@@ -2087,6 +3864,8 @@ void SdfText::drawGlyphs( const SdfText::Font::GlyphMeasuresList &glyphMeasures,
 
 void SdfText::drawGlyphs( const SdfText::Font::GlyphMeasuresList &glyphMeasures, const Rectf &clip, vec2 offset, const DrawOptions &options, const std::vector<ColorA8u> &colors )
 {
+	updateGlyphs( glyphMeasures );
+
 	const auto& textures = mTextureAtlases->mTextures;
 	const auto& glyphMap = mTextureAtlases->mGlyphInfo;
 	const auto& sdfPadding = mTextureAtlases->mSdfPadding;
@@ -2102,7 +3881,7 @@ void SdfText::drawGlyphs( const SdfText::Font::GlyphMeasuresList &glyphMeasures,
 
 	auto shader = options.getGlslProg();
 	if( ! shader ) {
-		shader = SdfText::defaultShader();
+		shader = SdfText::defaultShader( isSingleChannel() );
 	}
 	ScopedTextureBind texBindScp( textures[0] );
 	ScopedGlslProg glslScp( shader );
@@ -2205,6 +3984,12 @@ void SdfText::drawGlyphs( const SdfText::Font::GlyphMeasuresList &glyphMeasures,
 		}
 		
 		curTex->bind();
+#if defined(CINDER_GL_ES)
+		// Pages are sized to their glyphs, so they can differ in size
+		if( ! options.getGlslProg() ) {
+			shader->uniform( "uTexSize", vec2( curTex->getSize() ) );
+		}
+#endif
 		auto ctx = gl::context();
 		size_t dataSize = (verts.size() + texCoords.size()) * sizeof(float) + vertColors.size() * sizeof(ColorA8u);
 		gl::ScopedVao vaoScp( ctx->getDefaultVao() );
@@ -2270,6 +4055,8 @@ void SdfText::drawStringWrapped( const std::string &str, const Rectf &fitRect, c
 
 std::vector<std::pair<uint8_t, std::vector<SdfText::CharPlacement>>> SdfText::placeChars( const SdfText::Font::GlyphMeasuresList &glyphMeasures, const vec2 &baselineIn, const DrawOptions &options )
 {
+	updateGlyphs( glyphMeasures );
+
 	std::vector<std::pair<uint8_t, std::vector<SdfText::CharPlacement>>> result;
 
 	const auto& textures = mTextureAtlases->mTextures;
@@ -2537,17 +4324,34 @@ const gl::TextureRef& SdfText::getTexture(uint32_t n) const
 	return mTextureAtlases->mTextures[static_cast<size_t>( n )];
 }
 
-gl::GlslProgRef SdfText::defaultShader()
+uint32_t SdfText::getSimplifiedEdges( SdfText::Font::Glyph glyph ) const
 {
-	if( ! sDefaultShader ) {
+	auto glyphInfoIt = mTextureAtlases->mGlyphInfo.find( glyph );
+	return ( mTextureAtlases->mGlyphInfo.end() != glyphInfoIt ) ? glyphInfoIt->second.mSimplifiedEdges : 0;
+}
+
+gl::GlslProgRef SdfText::defaultShader( bool singleChannel )
+{
+	gl::GlslProgRef& shader = singleChannel ? sDefaultSingleChannelShader : sDefaultShader;
+	if( ! shader ) {
 		try {
-			sDefaultShader = gl::GlslProg::create( kSdfVertShader, kSdfFragShader );
+			// The single-channel variant is the same shader with the field sampled from the red channel
+			std::string fragShader = kSdfFragShader;
+			if( singleChannel ) {
+				fragShader.insert( fragShader.find( '\n' ) + 1, "#define SDF_SINGLE_CHANNEL\n" );
+			}
+			shader = gl::GlslProg::create( kSdfVertShader, fragShader );
 		}
 		catch( const std::exception& e ) {
 			CI_LOG_E( "SdfText::defaultShader error: " << e.what() );
 		}
 	}
-	return sDefaultShader;
+	return shader;
+}
+
+bool SdfText::isSingleChannel() const
+{
+	return mTextureAtlases && mTextureAtlases->mSingleChannel;
 }
 
 }} // namespace cinder::gl
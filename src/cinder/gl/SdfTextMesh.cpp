@@ -360,8 +360,8 @@ void SdfTextMesh::cache()
 				textBatch.mVertexBuffer = Vbo::create( GL_ARRAY_BUFFER );
 				// Create vbo mesh - index count is passed in to prevent data corruption on NVIDIA cards
 				VboMeshRef vboMesh = VboMesh::create( 0, GL_TRIANGLES, { std::make_pair( vertexLayout, textBatch.mVertexBuffer  ) }, mesh.getNumIndices(), GL_UNSIGNED_INT, textBatch.mIndexBuffer );
-				// Create batch using vbo mesh and default SdfText sahder
-				textBatch.mBatch = Batch::create( vboMesh, SdfText::defaultShader() );
+				// Create batch using vbo mesh and default SdfText sahder, single-channel atlases need their own variant
+				textBatch.mBatch = Batch::create( vboMesh, SdfText::defaultShader( sdfText->isSingleChannel() ) );
 			}
 
 			// Buffer index and vertex data
@@ -0,0 +1,208 @@
+
+#include "msdfgen/core/CompiledShape.h"
+
+#include "msdfgen/core/edge-kernels.h"
+
+#define LARGE_VALUE 1e240
+
+namespace msdfgen {
+
+template <typename T>
+CompiledLinearSegmentT<T>::CompiledLinearSegmentT(const Point2 *p) {
+    Vector2 ab = p[1]-p[0];
+    this->p[0] = Vector2T<T>(p[0]);
+    this->p[1] = Vector2T<T>(p[1]);
+    this->ab = Vector2T<T>(ab);
+    orthonormal = Vector2T<T>(ab.getOrthonormal(false));
+    direction = Vector2T<T>(ab.normalize());
+    abLengthSquared = T(dotProduct(ab, ab));
+}
+
+template <typename T>
+CompiledQuadraticSegmentT<T>::CompiledQuadraticSegmentT(const Point2 *p) {
+    for (int i = 0; i < 3; ++i)
+        this->p[i] = Vector2T<T>(p[i]);
+    Vector2 ab = p[1]-p[0];
+    Vector2 br = p[0]+p[2]-p[1]-p[1];
+    Vector2 bc = p[2]-p[1];
+    this->ab = Vector2T<T>(ab);
+    this->br = Vector2T<T>(br);
+    this->bc = Vector2T<T>(bc);
+    ac = Vector2T<T>(p[2]-p[0]);
+    startDirection = Vector2T<T>(ab.normalize());
+    endDirection = Vector2T<T>(bc.normalize());
+    a = T(dotProduct(br, br));
+    b = T(3*dotProduct(ab, br));
+    c0 = T(2*dotProduct(ab, ab));
+    abLengthSquared = T(dotProduct(ab, ab));
+    bcLengthSquared = T(dotProduct(bc, bc));
+}
+
+template <typename T>
+CompiledCubicSegmentT<T>::CompiledCubicSegmentT(const Point2 *p) {
+    for (int i = 0; i < 4; ++i)
+        this->p[i] = Vector2T<T>(p[i]);
+    Vector2 ab = p[1]-p[0];
+    Vector2 bc = p[2]-p[1];
+    Vector2 cd = p[3]-p[2];
+    Vector2 br = p[2]-p[1]-ab;
+    Vector2 as = (p[3]-p[2])-(p[2]-p[1])-br;
+    this->ab = Vector2T<T>(ab);
+    this->bc = Vector2T<T>(bc);
+    this->cd = Vector2T<T>(cd);
+    startDirection = Vector2T<T>(ab.normalize());
+    endDirection = Vector2T<T>(cd.normalize());
+    ab3 = Vector2T<T>(3*ab);
+    br6 = Vector2T<T>(6*br);
+    as3 = Vector2T<T>(3*as);
+    as6 = Vector2T<T>(6*as);
+    abLengthSquared = T(dotProduct(ab, ab));
+    cdLengthSquared = T(dotProduct(cd, cd));
+}
+
+template <typename T>
+const int CompiledShapeT<T>::BATCH_SIZE;
+
+static void pointBounds(Point2 p, double &l, double &b, double &r, double &t) {
+    if (p.x < l) l = p.x;
+    if (p.y < b) b = p.y;
+    if (p.x > r) r = p.x;
+    if (p.y > t) t = p.y;
+}
+
+template <typename T>
+CompiledShapeT<T>::CompiledShapeT(const Shape &shape) : inverseYAxis(shape.inverseYAxis) {
+    for (std::vector<Contour>::const_iterator contour = shape.contours.begin(); contour != shape.contours.end(); ++contour)
+        for (std::vector<EdgeHolder>::const_iterator edgeHolder = contour->edges.begin(); edgeHolder != contour->edges.end(); ++edgeHolder) {
+            const EdgeSegment *segment = *edgeHolder;
+            Edge edge;
+            edge.color = segment->color;
+            edge.source = segment;
+            edge.start = Vector2T<T>(segment->point(0));
+            edge.end = Vector2T<T>(segment->point(1));
+            edge.startDirection = Vector2T<T>(segment->direction(0).normalize());
+            edge.endDirection = Vector2T<T>(segment->direction(1).normalize());
+            double l = LARGE_VALUE, b = LARGE_VALUE, r = -LARGE_VALUE, t = -LARGE_VALUE;
+            const Point2 *controlPoints = NULL;
+            int controlPointCount = 0;
+            if (const LinearSegment *e = dynamic_cast<const LinearSegment *>(segment)) {
+                edge.type = LINEAR;
+                edge.index = (int) linearSegments.size();
+                linearSegments.push_back(CompiledLinearSegmentT<T>(e->p));
+                controlPoints = e->p, controlPointCount = 2;
+            } else if (const QuadraticSegment *e = dynamic_cast<const QuadraticSegment *>(segment)) {
+                edge.type = QUADRATIC;
+                edge.index = (int) quadraticSegments.size();
+                quadraticSegments.push_back(CompiledQuadraticSegmentT<T>(e->p));
+                controlPoints = e->p, controlPointCount = 3;
+            } else if (const CubicSegment *e = dynamic_cast<const CubicSegment *>(segment)) {
+                edge.type = CUBIC;
+                edge.index = (int) cubicSegments.size();
+                cubicSegments.push_back(CompiledCubicSegmentT<T>(e->p));
+                controlPoints = e->p, controlPointCount = 4;
+            } else {
+                edge.type = OTHER;
+                edge.index = -1;
+                segment->bounds(l, b, r, t);
+            }
+            for (int i = 0; i < controlPointCount; ++i)
+                pointBounds(controlPoints[i], l, b, r, t);
+            edge.l = T(l), edge.b = T(b), edge.r = T(r), edge.t = T(t);
+            for (int channel = 0; channel < 3; ++channel)
+                if (edge.color&(1<<channel))
+                    channelEdges[channel].push_back((int) edges.size());
+            edges.push_back(edge);
+        }
+}
+
+static void sourceSignedDistanceBatch(const EdgeSegment *source, const double *x, const double *y, SignedDistance *distance, double *param) {
+    source->signedDistanceBatch(x, y, distance, param);
+}
+
+static void sourceSignedDistanceBatch(const EdgeSegment *source, const float *x, const float *y, SignedDistancef *distance, float *param) {
+    for (int offset = 0; offset < CompiledShapef::BATCH_SIZE; offset += MSDFGEN_BATCH_SIZE) {
+        double dx[MSDFGEN_BATCH_SIZE], dy[MSDFGEN_BATCH_SIZE], dparam[MSDFGEN_BATCH_SIZE];
+        SignedDistance ddistance[MSDFGEN_BATCH_SIZE];
+        for (int i = 0; i < MSDFGEN_BATCH_SIZE; ++i)
+            dx[i] = x[offset+i], dy[i] = y[offset+i];
+        source->signedDistanceBatch(dx, dy, ddistance, dparam);
+        for (int i = 0; i < MSDFGEN_BATCH_SIZE; ++i) {
+            distance[offset+i] = SignedDistancef(float(ddistance[i].distance), float(ddistance[i].dot));
+            param[offset+i] = float(dparam[i]);
+        }
+    }
+}
+
+template <typename T>
+void CompiledShapeT<T>::signedDistanceBatch(const Edge &edge, const T *x, const T *y, SignedDistanceT<T> *distance, T *param) const {
+    const EdgeKernelsT<T> &kernels = getEdgeKernels<T>();
+    switch (edge.type) {
+        case LINEAR:
+            kernels.linear(linearSegments[edge.index], x, y, distance, param);
+            break;
+        case QUADRATIC:
+            kernels.quadratic(quadraticSegments[edge.index], x, y, distance, param);
+            break;
+        case CUBIC:
+            kernels.cubic(cubicSegments[edge.index], x, y, distance, param);
+            break;
+        default:
+            sourceSignedDistanceBatch(edge.source, x, y, distance, param);
+    }
+}
+
+template <typename T>
+void CompiledShapeT<T>::distanceToPseudoDistance(const Edge &edge, SignedDistanceT<T> &distance, Vector2T<T> origin, T param) {
+    if (param < 0) {
+        Vector2T<T> aq = origin-edge.start;
+        T ts = dotProduct(aq, edge.startDirection);
+        if (ts < 0) {
+            T pseudoDistance = crossProduct(aq, edge.startDirection);
+            if (fabs(pseudoDistance) <= fabs(distance.distance)) {
+                distance.distance = pseudoDistance;
+                distance.dot = 0;
+            }
+        }
+    } else if (param > 1) {
+        Vector2T<T> bq = origin-edge.end;
+        T ts = dotProduct(bq, edge.endDirection);
+        if (ts > 0) {
+            T pseudoDistance = crossProduct(bq, edge.endDirection);
+            if (fabs(pseudoDistance) <= fabs(distance.distance)) {
+                distance.distance = pseudoDistance;
+                distance.dot = 0;
+            }
+        }
+    }
+}
+
+template <typename T>
+void CompiledShapeT<T>::scanline(Scanline &line, double y) const {
+    std::vector<Scanline::Intersection> intersections;
+    double x[3];
+    int dy[3];
+    for (typename std::vector<Edge>::const_iterator edge = edges.begin(); edge != edges.end(); ++edge) {
+        int n = edge->source->scanlineIntersections(x, dy, y);
+        for (int i = 0; i < n; ++i) {
+            Scanline::Intersection intersection = { x[i], dy[i] };
+            intersections.push_back(intersection);
+        }
+    }
+#ifdef MSDFGEN_USE_CPP11
+    line.setIntersections((std::vector<Scanline::Intersection> &&) intersections);
+#else
+    line.setIntersections(intersections);
+#endif
+}
+
+template struct CompiledLinearSegmentT<double>;
+template struct CompiledQuadraticSegmentT<double>;
+template struct CompiledCubicSegmentT<double>;
+template class CompiledShapeT<double>;
+
+template struct CompiledLinearSegmentT<float>;
+template struct CompiledQuadraticSegmentT<float>;
+template struct CompiledCubicSegmentT<float>;
+template class CompiledShapeT<float>;
+
+}
@@ -0,0 +1,82 @@
+
+#include "msdfgen/core/EdgeArena.h"
+
+#include <new>
+
+#ifdef _MSC_VER
+#define MSDFGEN_THREAD_LOCAL __declspec(thread)
+#else
+#define MSDFGEN_THREAD_LOCAL __thread
+#endif
+
+namespace msdfgen {
+
+/// Precedes every allocation, identifies the arena it belongs to, or NULL for the heap. Its size keeps the objects aligned.
+union AllocationHeader {
+    EdgeArena *arena;
+    long double alignment;
+};
+
+static MSDFGEN_THREAD_LOCAL EdgeArena *currentArena = NULL;
+
+EdgeArena::Scope::Scope(EdgeArena &arena) : previous(currentArena) {
+    currentArena = &arena;
+}
+
+EdgeArena::Scope::~Scope() {
+    currentArena = previous;
+}
+
+EdgeArena::EdgeArena(size_t blockSize) : blockSize(blockSize), block(0), offset(0) { }
+
+EdgeArena::~EdgeArena() {
+    for (std::vector<char *>::iterator it = blocks.begin(); it != blocks.end(); ++it)
+        ::operator delete(*it);
+}
+
+void EdgeArena::reset() {
+    block = 0;
+    offset = 0;
+}
+
+size_t EdgeArena::capacity() const {
+    size_t total = 0;
+    for (std::vector<size_t>::const_iterator it = blockSizes.begin(); it != blockSizes.end(); ++it)
+        total += *it;
+    return total;
+}
+
+void * EdgeArena::allocateHere(size_t size) {
+    size = (size+sizeof(AllocationHeader)-1)/sizeof(AllocationHeader)*sizeof(AllocationHeader);
+    // Continue in the next block that is large enough, allocating a new one if there is none
+    while (block < blocks.size() && offset+size > blockSizes[block]) {
+        ++block;
+        offset = 0;
+    }
+    if (block == blocks.size()) {
+        size_t newSize = size > blockSize ? size : blockSize;
+        blocks.push_back(static_cast<char *>(::operator new(newSize)));
+        blockSizes.push_back(newSize);
+        offset = 0;
+    }
+    void *ptr = blocks[block]+offset;
+    offset += size;
+    return ptr;
+}
+
+void * EdgeArena::allocate(size_t size) {
+    EdgeArena *arena = currentArena;
+    AllocationHeader *header = static_cast<AllocationHeader *>(arena ? arena->allocateHere(sizeof(AllocationHeader)+size) : ::operator new(sizeof(AllocationHeader)+size));
+    header->arena = arena;
+    return header+1;
+}
+
+void EdgeArena::deallocate(void *ptr) {
+    if (!ptr)
+        return;
+    AllocationHeader *header = static_cast<AllocationHeader *>(ptr)-1;
+    if (!header->arena)
+        ::operator delete(header);
+}
+
+}
@@ -0,0 +1,98 @@
+
+#include "msdfgen/core/EdgeIndex.h"
+
+#define LARGE_VALUE 1e240
+
+namespace msdfgen {
+
+/// The rounding error of distances computed with the scalar type, relative to the magnitude of the coordinates.
+template <typename T>
+static double relativeTolerance() {
+    return 1e-9;
+}
+
+template <>
+double relativeTolerance<float>() {
+    return 1e-4;
+}
+
+template <typename T>
+EdgeIndexT<T>::EdgeIndexT(const CompiledShapeT<T> &shape, int width, int height, const Vector2 &scale, const Vector2 &translate, bool multiChannel) : tilesX(0), tolerance(0) {
+    double extent = 1;
+    for (typename std::vector<Entry>::const_iterator edge = shape.edges.begin(); edge != shape.edges.end(); ++edge)
+        extent = max(extent, max(max(fabs(edge->l), fabs(edge->r)), max(fabs(edge->b), fabs(edge->t))));
+    if (width <= 0 || height <= 0)
+        return;
+
+    Point2 lowCorner = Vector2(.5, .5)/scale-translate;
+    Point2 highCorner = Vector2(width-.5, height-.5)/scale-translate;
+    extent = max(extent, max(max(fabs(lowCorner.x), fabs(lowCorner.y)), max(fabs(highCorner.x), fabs(highCorner.y))));
+    // Absorbs rounding errors of the distance computation, which may otherwise lead to edges being skipped incorrectly
+    tolerance = T(relativeTolerance<T>()*extent);
+
+    tilesX = (width+TILE_SIZE-1)/TILE_SIZE;
+    int tilesY = (height+TILE_SIZE-1)/TILE_SIZE;
+    tileOffsets.reserve(tilesX*tilesY+1);
+    tileDistances.reserve(tilesX*tilesY);
+    std::vector<double> lowerBounds(shape.edges.size()), upperBounds(shape.edges.size());
+    for (int ty = 0; ty < tilesY; ++ty)
+        for (int tx = 0; tx < tilesX; ++tx) {
+            tileOffsets.push_back((int) candidates.size());
+            // Area spanned by the centers of the tile's pixels
+            Point2 a = Vector2(tx*TILE_SIZE+.5, ty*TILE_SIZE+.5)/scale-translate;
+            Point2 b = Vector2(min((tx+1)*TILE_SIZE, width)-.5, min((ty+1)*TILE_SIZE, height)-.5)/scale-translate;
+            double l = min(a.x, b.x), r = max(a.x, b.x), bottom = min(a.y, b.y), top = max(a.y, b.y);
+
+            // Any edge is at most as far from a pixel as its start point, so the nearest edge of each channel
+            // cannot be farther than the smallest of the start points' maximum distances from the tile.
+            for (size_t i = 0; i < shape.edges.size(); ++i) {
+                const Entry &edge = shape.edges[i];
+                double dx = max(max(edge.l-r, l-edge.r), 0.);
+                double dy = max(max(edge.b-top, bottom-edge.t), 0.);
+                lowerBounds[i] = sqrt(dx*dx+dy*dy);
+                double farX = max(fabs(edge.start.x-l), fabs(edge.start.x-r));
+                double farY = max(fabs(edge.start.y-bottom), fabs(edge.start.y-top));
+                upperBounds[i] = sqrt(farX*farX+farY*farY);
+            }
+            double tileDistance = LARGE_VALUE;
+            for (size_t i = 0; i < shape.edges.size(); ++i)
+                tileDistance = min(tileDistance, lowerBounds[i]-tolerance);
+            tileDistances.push_back(max(tileDistance, 0.));
+            double channelBounds[3] = { LARGE_VALUE, LARGE_VALUE, LARGE_VALUE };
+            if (multiChannel) {
+                for (int channel = 0; channel < 3; ++channel)
+                    for (std::vector<int>::const_iterator edge = shape.channelEdges[channel].begin(); edge != shape.channelEdges[channel].end(); ++edge)
+                        channelBounds[channel] = min(channelBounds[channel], upperBounds[*edge]);
+            } else {
+                for (size_t i = 0; i < shape.edges.size(); ++i)
+                    channelBounds[0] = min(channelBounds[0], upperBounds[i]);
+            }
+            for (size_t i = 0; i < shape.edges.size(); ++i) {
+                const Entry &edge = shape.edges[i];
+                double lowerBound = lowerBounds[i]-tolerance;
+                bool candidate;
+                if (multiChannel) {
+                    candidate = (edge.color&RED && lowerBound <= channelBounds[0])
+                        || (edge.color&GREEN && lowerBound <= channelBounds[1])
+                        || (edge.color&BLUE && lowerBound <= channelBounds[2]);
+                } else
+                    candidate = lowerBound <= channelBounds[0];
+                if (candidate)
+                    candidates.push_back(&edge);
+            }
+        }
+    tileOffsets.push_back((int) candidates.size());
+}
+
+template <typename T>
+void EdgeIndexT<T>::tileEntries(int x, int y, const Entry * const *&begin, const Entry * const *&end) const {
+    int tile = (y/TILE_SIZE)*tilesX+x/TILE_SIZE;
+    const Entry * const *base = candidates.empty() ? NULL : &candidates[0];
+    begin = base+tileOffsets[tile];
+    end = base+tileOffsets[tile+1];
+}
+
+template class EdgeIndexT<double>;
+template class EdgeIndexT<float>;
+
+}
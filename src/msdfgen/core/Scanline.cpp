@@ -0,0 +1,50 @@
+
+#include "msdfgen/core/Scanline.h"
+
+#include <algorithm>
+
+namespace msdfgen {
+
+static bool compareIntersections(const Scanline::Intersection &a, const Scanline::Intersection &b) {
+    return a.x < b.x;
+}
+
+void Scanline::setIntersections(const std::vector<Intersection> &intersections) {
+    this->intersections = intersections;
+    preprocess();
+}
+
+#ifdef MSDFGEN_USE_CPP11
+void Scanline::setIntersections(std::vector<Intersection> &&intersections) {
+    this->intersections = (std::vector<Intersection> &&) intersections;
+    preprocess();
+}
+#endif
+
+void Scanline::preprocess() {
+    std::sort(intersections.begin(), intersections.end(), compareIntersections);
+    int winding = 0;
+    for (std::vector<Intersection>::iterator intersection = intersections.begin(); intersection != intersections.end(); ++intersection) {
+        winding += intersection->direction;
+        intersection->direction = winding;
+    }
+}
+
+int Scanline::winding(double x) const {
+    // The last intersection left of x
+    int lo = -1, hi = (int) intersections.size();
+    while (hi-lo > 1) {
+        int mid = (lo+hi)/2;
+        if (intersections[mid].x < x)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return lo < 0 ? 0 : intersections[lo].direction;
+}
+
+bool Scanline::filled(double x) const {
+    return winding(x) != 0;
+}
+
+}
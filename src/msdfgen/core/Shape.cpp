@@ -1,6 +1,10 @@
 
 #include "msdfgen/core/Shape.h"
 
+#include <cmath>
+#include <algorithm>
+#include "msdfgen/core/arithmetics.hpp"
+
 namespace msdfgen {
 
 Shape::Shape() : inverseYAxis(false) { }
@@ -48,9 +52,183 @@ void Shape::normalize() {
         }
 }
 
+/// Evaluates the blossom of a cubic curve. The control points of the part of the curve between t0 and t1
+/// are given by the arguments (t0, t0, t0), (t0, t0, t1), (t0, t1, t1) and (t1, t1, t1).
+static Point2 cubicBlossom(const Point2 *p, double u, double v, double w) {
+    Point2 a = mix(p[0], p[1], u), b = mix(p[1], p[2], u), c = mix(p[2], p[3], u);
+    return mix(mix(a, b, v), mix(b, c, v), w);
+}
+
+static void approximateCubic(std::vector<EdgeHolder> &output, const CubicSegment &cubic, double tolerance, bool toLines) {
+    const Point2 *p = cubic.p;
+    int parts;
+    if (toLines) {
+        // The distance between a curve and its chord is at most 1/8 of the maximum second derivative
+        double secondDifference = max((p[2]-2*p[1]+p[0]).length(), (p[3]-2*p[2]+p[1]).length());
+        parts = (int) ceil(sqrt(.75*secondDifference/tolerance));
+    } else {
+        // A quadratic curve with the control point (3*(p1+p2)-p0-p3)/4 deviates from the cubic by at most sqrt(3)/36 of its third difference
+        double thirdDifference = (p[3]-3*p[2]+3*p[1]-p[0]).length();
+        parts = (int) ceil(pow(sqrt(3.)/36*thirdDifference/tolerance, 1/3.));
+    }
+    parts = max(parts, 1);
+    Point2 start = p[0];
+    for (int i = 0; i < parts; ++i) {
+        double t0 = (double) i/parts, t1 = (double) (i+1)/parts;
+        Point2 end = i == parts-1 ? p[3] : cubic.point(t1);
+        if (toLines)
+            output.push_back(EdgeHolder(start, end, cubic.color));
+        else {
+            Point2 control = .25*(3*(cubicBlossom(p, t0, t0, t1)+cubicBlossom(p, t0, t1, t1))-start-end);
+            output.push_back(EdgeHolder(start, control, end, cubic.color));
+        }
+        start = end;
+    }
+}
+
+void Shape::approximateCubics(double tolerance, bool toLines) {
+    if (!(tolerance > 0))
+        return;
+    for (std::vector<Contour>::iterator contour = contours.begin(); contour != contours.end(); ++contour) {
+        std::vector<EdgeHolder> edges;
+        edges.reserve(contour->edges.size());
+        for (std::vector<EdgeHolder>::iterator edge = contour->edges.begin(); edge != contour->edges.end(); ++edge) {
+            if (const CubicSegment *cubic = dynamic_cast<const CubicSegment *>(&**edge))
+                approximateCubic(edges, *cubic, tolerance, toLines);
+            else
+                edges.push_back(*edge);
+        }
+        contour->edges.swap(edges);
+    }
+}
+
+/// Returns whether a curve deviates from its chord by at most tolerance. The difference between a Bezier curve and its chord,
+/// parametrized uniformly, is a Bezier curve with zero end points, whose control points are the differences of the inner control points
+/// from the points that divide the chord evenly. It is at most 1/2 (quadratic) or 3/4 (cubic) of their maximum.
+static bool isNearlyFlat(const EdgeSegment *edge, double tolerance) {
+    if (const QuadraticSegment *quadratic = dynamic_cast<const QuadraticSegment *>(edge)) {
+        const Point2 *p = quadratic->p;
+        return .5*(p[1]-mix(p[0], p[2], .5)).length() <= tolerance;
+    }
+    if (const CubicSegment *cubic = dynamic_cast<const CubicSegment *>(edge)) {
+        const Point2 *p = cubic->p;
+        return .75*max((p[1]-mix(p[0], p[3], 1/3.)).length(), (p[2]-mix(p[0], p[3], 2/3.)).length()) <= tolerance;
+    }
+    return false;
+}
+
+/// Returns whether the edge starts and ends at the same point, and its control points are within tolerance of it.
+static bool isDegenerate(const EdgeSegment *edge, double tolerance) {
+    Point2 start = edge->point(0);
+    if (edge->point(1) != start)
+        return false;
+    if (const QuadraticSegment *quadratic = dynamic_cast<const QuadraticSegment *>(edge))
+        return (quadratic->p[1]-start).length() <= tolerance;
+    if (const CubicSegment *cubic = dynamic_cast<const CubicSegment *>(edge))
+        return (cubic->p[1]-start).length() <= tolerance && (cubic->p[2]-start).length() <= tolerance;
+    return dynamic_cast<const LinearSegment *>(edge) != NULL;
+}
+
+/// Returns the distance of point from the line segment between a and b.
+static double segmentDistance(Point2 point, Point2 a, Point2 b) {
+    Vector2 ab = b-a;
+    double lengthSquared = dotProduct(ab, ab);
+    double t = lengthSquared > 0 ? clamp(dotProduct(point-a, ab)/lengthSquared, 0., 1.) : 0.;
+    return (point-(a+t*ab)).length();
+}
+
+/// Returns whether the polyline through points and end can be replaced by the line segment between its first point and end,
+/// which is the case if all of its inner points are within tolerance of the line segment. The whole polyline then is.
+static bool isMergeable(const std::vector<Point2> &points, Point2 end, double tolerance) {
+    for (std::vector<Point2>::const_iterator point = points.begin()+1; point != points.end(); ++point)
+        if (segmentDistance(*point, points.front(), end) > tolerance)
+            return false;
+    return true;
+}
+
+int Shape::simplify(double tolerance) {
+    if (!(tolerance > 0))
+        return 0;
+    // Half of the tolerance is available to replacing curves with lines, the other half to merging the lines
+    double halfTolerance = .5*tolerance;
+    int removed = 0;
+    for (std::vector<Contour>::iterator contour = contours.begin(); contour != contours.end(); ++contour) {
+        std::vector<EdgeHolder> edges;
+        edges.reserve(contour->edges.size());
+        for (std::vector<EdgeHolder>::iterator edge = contour->edges.begin(); edge != contour->edges.end(); ++edge) {
+            if (isDegenerate(*edge, halfTolerance))
+                continue;
+            if (isNearlyFlat(*edge, halfTolerance))
+                edges.push_back(EdgeHolder((*edge)->point(0), (*edge)->point(1), (*edge)->color));
+            else
+                edges.push_back(*edge);
+        }
+
+        // Start at an edge that cannot be merged with the previous one, so that no run of lines wraps around the end of the contour
+        int n = (int) edges.size();
+        for (int i = 0; i < n; ++i) {
+            const EdgeSegment *prev = edges[(i+n-1)%n], *cur = edges[i];
+            if (!(dynamic_cast<const LinearSegment *>(prev) && dynamic_cast<const LinearSegment *>(cur) && prev != cur &&
+                segmentDistance(cur->point(0), prev->point(0), cur->point(1)) <= halfTolerance)) {
+                std::rotate(edges.begin(), edges.begin()+i, edges.end());
+                break;
+            }
+        }
+
+        std::vector<EdgeHolder> merged;
+        merged.reserve(edges.size());
+        std::vector<Point2> run;
+        for (std::vector<EdgeHolder>::iterator edge = edges.begin(); edge != edges.end(); ++edge) {
+            if (dynamic_cast<const LinearSegment *>(&**edge)) {
+                Point2 start = (*edge)->point(0), end = (*edge)->point(1);
+                if (!run.empty()) {
+                    run.push_back(start);
+                    if (isMergeable(run, end, halfTolerance)) {
+                        merged.back()->moveEndPoint(end);
+                        continue;
+                    }
+                }
+                run.clear();
+                run.push_back(start);
+            } else
+                run.clear();
+            merged.push_back(*edge);
+        }
+        removed += (int) (contour->edges.size()-merged.size());
+        contour->edges.swap(merged);
+    }
+    // Remove contours whose edges were all degenerate
+    for (std::vector<Contour>::iterator contour = contours.begin(); contour != contours.end();) {
+        if (contour->edges.empty())
+            contour = contours.erase(contour);
+        else
+            ++contour;
+    }
+    return removed;
+}
+
 void Shape::bounds(double &l, double &b, double &r, double &t) const {
     for (std::vector<Contour>::const_iterator contour = contours.begin(); contour != contours.end(); ++contour)
         contour->bounds(l, b, r, t);
 }
 
+void Shape::scanline(Scanline &line, double y) const {
+    std::vector<Scanline::Intersection> intersections;
+    double x[3];
+    int dy[3];
+    for (std::vector<Contour>::const_iterator contour = contours.begin(); contour != contours.end(); ++contour)
+        for (std::vector<EdgeHolder>::const_iterator edge = contour->edges.begin(); edge != contour->edges.end(); ++edge) {
+            int n = (*edge)->scanlineIntersections(x, dy, y);
+            for (int i = 0; i < n; ++i) {
+                Scanline::Intersection intersection = { x[i], dy[i] };
+                intersections.push_back(intersection);
+            }
+        }
+#ifdef MSDFGEN_USE_CPP11
+    line.setIntersections((std::vector<Scanline::Intersection> &&) intersections);
+#else
+    line.setIntersections(intersections);
+#endif
+}
+
 }
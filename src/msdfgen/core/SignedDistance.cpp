@@ -2,29 +2,60 @@
 #include "msdfgen/core/SignedDistance.h"
 
 #include <cmath>
+#include <limits>
 
 namespace msdfgen {
 
-const SignedDistance SignedDistance::INFINITE(-1e240, 1);
+/// The distance of an empty shape. Single precision cannot represent the value used by double precision and uses infinity instead.
+template <typename T>
+static T infiniteDistance() {
+    return T(-1e240);
+}
+
+template <>
+float infiniteDistance<float>() {
+    return -std::numeric_limits<float>::infinity();
+}
 
-SignedDistance::SignedDistance() : distance(-1e240), dot(1) { }
+template <typename T>
+const SignedDistanceT<T> SignedDistanceT<T>::INFINITE(infiniteDistance<T>(), 1);
 
-SignedDistance::SignedDistance(double dist, double d) : distance(dist), dot(d) { }
+template <typename T>
+SignedDistanceT<T>::SignedDistanceT() : distance(infiniteDistance<T>()), dot(1) { }
 
-bool operator<(SignedDistance a, SignedDistance b) {
+template <typename T>
+SignedDistanceT<T>::SignedDistanceT(T dist, T d) : distance(dist), dot(d) { }
+
+template <typename T>
+bool operator<(SignedDistanceT<T> a, SignedDistanceT<T> b) {
     return fabs(a.distance) < fabs(b.distance) || (fabs(a.distance) == fabs(b.distance) && a.dot < b.dot);
 }
 
-bool operator>(SignedDistance a, SignedDistance b) {
+template <typename T>
+bool operator>(SignedDistanceT<T> a, SignedDistanceT<T> b) {
     return fabs(a.distance) > fabs(b.distance) || (fabs(a.distance) == fabs(b.distance) && a.dot > b.dot);
 }
 
-bool operator<=(SignedDistance a, SignedDistance b) {
+template <typename T>
+bool operator<=(SignedDistanceT<T> a, SignedDistanceT<T> b) {
     return fabs(a.distance) < fabs(b.distance) || (fabs(a.distance) == fabs(b.distance) && a.dot <= b.dot);
 }
 
-bool operator>=(SignedDistance a, SignedDistance b) {
+template <typename T>
+bool operator>=(SignedDistanceT<T> a, SignedDistanceT<T> b) {
     return fabs(a.distance) > fabs(b.distance) || (fabs(a.distance) == fabs(b.distance) && a.dot >= b.dot);
 }
 
+template class SignedDistanceT<double>;
+template bool operator<(SignedDistance a, SignedDistance b);
+template bool operator>(SignedDistance a, SignedDistance b);
+template bool operator<=(SignedDistance a, SignedDistance b);
+template bool operator>=(SignedDistance a, SignedDistance b);
+
+template class SignedDistanceT<float>;
+template bool operator<(SignedDistancef a, SignedDistancef b);
+template bool operator>(SignedDistancef a, SignedDistancef b);
+template bool operator<=(SignedDistancef a, SignedDistancef b);
+template bool operator>=(SignedDistancef a, SignedDistancef b);
+
 }
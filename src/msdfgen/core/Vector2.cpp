@@ -3,144 +3,188 @@
 
 namespace msdfgen {
 
-Vector2::Vector2(double val) : x(val), y(val) { }
+template <typename T>
+Vector2T<T>::Vector2T(T val) : x(val), y(val) { }
 
-Vector2::Vector2(double x, double y) : x(x), y(y) { }
+template <typename T>
+Vector2T<T>::Vector2T(T x, T y) : x(x), y(y) { }
 
-void Vector2::reset() {
+template <typename T>
+void Vector2T<T>::reset() {
     x = 0, y = 0;
 }
 
-void Vector2::set(double x, double y) {
-    Vector2::x = x, Vector2::y = y;
+template <typename T>
+void Vector2T<T>::set(T x, T y) {
+    Vector2T::x = x, Vector2T::y = y;
 }
 
-double Vector2::length() const {
-    return sqrt(x*x+y*y);
+template <typename T>
+T Vector2T<T>::length() const {
+    return T(sqrt(x*x+y*y));
 }
 
-double Vector2::direction() const {
-    return atan2(y, x);
+template <typename T>
+T Vector2T<T>::direction() const {
+    return T(atan2(y, x));
 }
 
-Vector2 Vector2::normalize(bool allowZero) const {
-    double len = length();
+template <typename T>
+Vector2T<T> Vector2T<T>::normalize(bool allowZero) const {
+    T len = length();
     if (len == 0)
-        return Vector2(0, !allowZero);
-    return Vector2(x/len, y/len);
+        return Vector2T(0, !allowZero);
+    return Vector2T(x/len, y/len);
 }
 
-Vector2 Vector2::getOrthogonal(bool polarity) const {
-    return polarity ? Vector2(-y, x) : Vector2(y, -x);
+template <typename T>
+Vector2T<T> Vector2T<T>::getOrthogonal(bool polarity) const {
+    return polarity ? Vector2T(-y, x) : Vector2T(y, -x);
 }
 
-Vector2 Vector2::getOrthonormal(bool polarity, bool allowZero) const {
-    double len = length();
+template <typename T>
+Vector2T<T> Vector2T<T>::getOrthonormal(bool polarity, bool allowZero) const {
+    T len = length();
     if (len == 0)
-        return polarity ? Vector2(0, !allowZero) : Vector2(0, -!allowZero);
-    return polarity ? Vector2(-y/len, x/len) : Vector2(y/len, -x/len);
+        return polarity ? Vector2T(0, !allowZero) : Vector2T(0, -!allowZero);
+    return polarity ? Vector2T(-y/len, x/len) : Vector2T(y/len, -x/len);
 }
 
-Vector2 Vector2::project(const Vector2 &vector, bool positive) const {
-    Vector2 n = normalize(true);
-    double t = dotProduct(vector, n);
+template <typename T>
+Vector2T<T> Vector2T<T>::project(const Vector2T &vector, bool positive) const {
+    Vector2T n = normalize(true);
+    T t = dotProduct(vector, n);
     if (positive && t <= 0)
-        return Vector2();
+        return Vector2T();
     return t*n;
 }
 
-Vector2::operator const void*() const {
+template <typename T>
+Vector2T<T>::operator const void*() const {
     return x || y ? this : NULL;
 }
 
-bool Vector2::operator!() const {
+template <typename T>
+bool Vector2T<T>::operator!() const {
     return !x && !y;
 }
 
-bool Vector2::operator==(const Vector2 &other) const {
+template <typename T>
+bool Vector2T<T>::operator==(const Vector2T &other) const {
     return x == other.x && y == other.y;
 }
 
-bool Vector2::operator!=(const Vector2 &other) const {
+template <typename T>
+bool Vector2T<T>::operator!=(const Vector2T &other) const {
     return x != other.x || y != other.y;
 }
 
-Vector2 Vector2::operator+() const {
+template <typename T>
+Vector2T<T> Vector2T<T>::operator+() const {
     return *this;
 }
 
-Vector2 Vector2::operator-() const {
-    return Vector2(-x, -y);
+template <typename T>
+Vector2T<T> Vector2T<T>::operator-() const {
+    return Vector2T(-x, -y);
 }
 
-Vector2 Vector2::operator+(const Vector2 &other) const {
-    return Vector2(x+other.x, y+other.y);
+template <typename T>
+Vector2T<T> Vector2T<T>::operator+(const Vector2T &other) const {
+    return Vector2T(x+other.x, y+other.y);
 }
 
-Vector2 Vector2::operator-(const Vector2 &other) const {
-    return Vector2(x-other.x, y-other.y);
+template <typename T>
+Vector2T<T> Vector2T<T>::operator-(const Vector2T &other) const {
+    return Vector2T(x-other.x, y-other.y);
 }
 
-Vector2 Vector2::operator*(const Vector2 &other) const {
-    return Vector2(x*other.x, y*other.y);
+template <typename T>
+Vector2T<T> Vector2T<T>::operator*(const Vector2T &other) const {
+    return Vector2T(x*other.x, y*other.y);
 }
 
-Vector2 Vector2::operator/(const Vector2 &other) const {
-    return Vector2(x/other.x, y/other.y);
+template <typename T>
+Vector2T<T> Vector2T<T>::operator/(const Vector2T &other) const {
+    return Vector2T(x/other.x, y/other.y);
 }
 
-Vector2 Vector2::operator*(double value) const {
-    return Vector2(x*value, y*value);
+template <typename T>
+Vector2T<T> Vector2T<T>::operator*(T value) const {
+    return Vector2T(x*value, y*value);
 }
 
-Vector2 Vector2::operator/(double value) const {
-    return Vector2(x/value, y/value);
+template <typename T>
+Vector2T<T> Vector2T<T>::operator/(T value) const {
+    return Vector2T(x/value, y/value);
 }
 
-Vector2 & Vector2::operator+=(const Vector2 &other) {
+template <typename T>
+Vector2T<T> & Vector2T<T>::operator+=(const Vector2T &other) {
     x += other.x, y += other.y;
     return *this;
 }
 
-Vector2 & Vector2::operator-=(const Vector2 &other) {
+template <typename T>
+Vector2T<T> & Vector2T<T>::operator-=(const Vector2T &other) {
     x -= other.x, y -= other.y;
     return *this;
 }
 
-Vector2 & Vector2::operator*=(const Vector2 &other) {
+template <typename T>
+Vector2T<T> & Vector2T<T>::operator*=(const Vector2T &other) {
     x *= other.x, y *= other.y;
     return *this;
 }
 
-Vector2 & Vector2::operator/=(const Vector2 &other) {
+template <typename T>
+Vector2T<T> & Vector2T<T>::operator/=(const Vector2T &other) {
     x /= other.x, y /= other.y;
     return *this;
 }
 
-Vector2 & Vector2::operator*=(double value) {
+template <typename T>
+Vector2T<T> & Vector2T<T>::operator*=(T value) {
     x *= value, y *= value;
     return *this;
 }
 
-Vector2 & Vector2::operator/=(double value) {
+template <typename T>
+Vector2T<T> & Vector2T<T>::operator/=(T value) {
     x /= value, y /= value;
     return *this;
 }
 
-double dotProduct(const Vector2 &a, const Vector2 &b) {
+template <typename T>
+T dotProduct(const Vector2T<T> &a, const Vector2T<T> &b) {
     return a.x*b.x+a.y*b.y;
 }
 
-double crossProduct(const Vector2 &a, const Vector2 &b) {
+template <typename T>
+T crossProduct(const Vector2T<T> &a, const Vector2T<T> &b) {
     return a.x*b.y-a.y*b.x;
 }
 
-Vector2 operator*(double value, const Vector2 &vector) {
-    return Vector2(value*vector.x, value*vector.y);
+template <typename T>
+Vector2T<T> operator*(typename Vector2T<T>::Scalar value, const Vector2T<T> &vector) {
+    return Vector2T<T>(value*vector.x, value*vector.y);
 }
 
-Vector2 operator/(double value, const Vector2 &vector) {
-    return Vector2(value/vector.x, value/vector.y);
+template <typename T>
+Vector2T<T> operator/(typename Vector2T<T>::Scalar value, const Vector2T<T> &vector) {
+    return Vector2T<T>(value/vector.x, value/vector.y);
 }
 
+template struct Vector2T<double>;
+template double dotProduct(const Vector2 &a, const Vector2 &b);
+template double crossProduct(const Vector2 &a, const Vector2 &b);
+template Vector2 operator*(double value, const Vector2 &vector);
+template Vector2 operator/(double value, const Vector2 &vector);
+
+template struct Vector2T<float>;
+template float dotProduct(const Vector2f &a, const Vector2f &b);
+template float crossProduct(const Vector2f &a, const Vector2f &b);
+template Vector2f operator*(float value, const Vector2f &vector);
+template Vector2f operator/(float value, const Vector2f &vector);
+
 }
@@ -0,0 +1,461 @@
+
+#include "msdfgen/core/edge-kernels.h"
+
+#include <cmath>
+#include <limits>
+#include "msdfgen/core/edge-segments.h"
+#include "msdfgen/core/equation-solver.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define MSDFGEN_SIMD_X86
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define MSDFGEN_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace msdfgen {
+
+namespace scalar {
+
+typedef double Scalar;
+static const int LANES = 1;
+
+struct Real {
+    double v;
+    Real() { }
+    explicit Real(double value) : v(value) { }
+};
+
+struct Mask {
+    bool v;
+    Mask(bool v) : v(v) { }
+};
+
+static inline Real load(const double *p) { return Real(*p); }
+static inline void store(double *p, Real a) { *p = a.v; }
+static inline Real operator+(Real a, Real b) { return Real(a.v+b.v); }
+static inline Real operator-(Real a, Real b) { return Real(a.v-b.v); }
+static inline Real operator-(Real a) { return Real(-a.v); }
+static inline Real operator*(Real a, Real b) { return Real(a.v*b.v); }
+static inline Real operator/(Real a, Real b) { return Real(a.v/b.v); }
+static inline Real sqrt(Real a) { return Real(::sqrt(a.v)); }
+static inline Real fabs(Real a) { return Real(::fabs(a.v)); }
+static inline Mask operator<(Real a, Real b) { return a.v < b.v; }
+static inline Mask operator<=(Real a, Real b) { return a.v <= b.v; }
+static inline Mask operator>(Real a, Real b) { return a.v > b.v; }
+static inline Mask operator>=(Real a, Real b) { return a.v >= b.v; }
+static inline Mask operator==(Real a, Real b) { return a.v == b.v; }
+static inline Mask operator&(Mask a, Mask b) { return a.v && b.v; }
+static inline Mask operator|(Mask a, Mask b) { return a.v || b.v; }
+static inline Mask operator~(Mask a) { return !a.v; }
+static inline Mask allLanes() { return true; }
+static inline bool any(Mask a) { return a.v; }
+static inline Real select(Mask mask, Real a, Real b) { return mask.v ? a : b; }
+
+#include "edge-kernels.hpp"
+
+}
+
+namespace scalarf {
+
+typedef float Scalar;
+static const int LANES = 1;
+
+struct Real {
+    float v;
+    Real() { }
+    explicit Real(float value) : v(value) { }
+};
+
+struct Mask {
+    bool v;
+    Mask(bool v) : v(v) { }
+};
+
+static inline Real load(const float *p) { return Real(*p); }
+static inline void store(float *p, Real a) { *p = a.v; }
+static inline Real operator+(Real a, Real b) { return Real(a.v+b.v); }
+static inline Real operator-(Real a, Real b) { return Real(a.v-b.v); }
+static inline Real operator-(Real a) { return Real(-a.v); }
+static inline Real operator*(Real a, Real b) { return Real(a.v*b.v); }
+static inline Real operator/(Real a, Real b) { return Real(a.v/b.v); }
+static inline Real sqrt(Real a) { return Real(std::sqrt(a.v)); }
+static inline Real fabs(Real a) { return Real(std::fabs(a.v)); }
+static inline Mask operator<(Real a, Real b) { return a.v < b.v; }
+static inline Mask operator<=(Real a, Real b) { return a.v <= b.v; }
+static inline Mask operator>(Real a, Real b) { return a.v > b.v; }
+static inline Mask operator>=(Real a, Real b) { return a.v >= b.v; }
+static inline Mask operator==(Real a, Real b) { return a.v == b.v; }
+static inline Mask operator&(Mask a, Mask b) { return a.v && b.v; }
+static inline Mask operator|(Mask a, Mask b) { return a.v || b.v; }
+static inline Mask operator~(Mask a) { return !a.v; }
+static inline Mask allLanes() { return true; }
+static inline bool any(Mask a) { return a.v; }
+static inline Real select(Mask mask, Real a, Real b) { return mask.v ? a : b; }
+
+#include "edge-kernels.hpp"
+
+}
+
+#ifdef MSDFGEN_SIMD_X86
+
+namespace sse2 {
+
+typedef double Scalar;
+static const int LANES = 2;
+
+struct Real {
+    __m128d v;
+    Real() { }
+    Real(__m128d v) : v(v) { }
+    explicit Real(double value) : v(_mm_set1_pd(value)) { }
+};
+
+struct Mask {
+    __m128d v;
+    Mask(__m128d v) : v(v) { }
+};
+
+static inline Real load(const double *p) { return _mm_loadu_pd(p); }
+static inline void store(double *p, Real a) { _mm_storeu_pd(p, a.v); }
+static inline Real operator+(Real a, Real b) { return _mm_add_pd(a.v, b.v); }
+static inline Real operator-(Real a, Real b) { return _mm_sub_pd(a.v, b.v); }
+static inline Real operator-(Real a) { return _mm_xor_pd(a.v, _mm_set1_pd(-0.)); }
+static inline Real operator*(Real a, Real b) { return _mm_mul_pd(a.v, b.v); }
+static inline Real operator/(Real a, Real b) { return _mm_div_pd(a.v, b.v); }
+static inline Real sqrt(Real a) { return _mm_sqrt_pd(a.v); }
+static inline Real fabs(Real a) { return _mm_andnot_pd(_mm_set1_pd(-0.), a.v); }
+static inline Mask operator<(Real a, Real b) { return _mm_cmplt_pd(a.v, b.v); }
+static inline Mask operator<=(Real a, Real b) { return _mm_cmple_pd(a.v, b.v); }
+static inline Mask operator>(Real a, Real b) { return _mm_cmpgt_pd(a.v, b.v); }
+static inline Mask operator>=(Real a, Real b) { return _mm_cmpge_pd(a.v, b.v); }
+static inline Mask operator==(Real a, Real b) { return _mm_cmpeq_pd(a.v, b.v); }
+static inline Mask operator&(Mask a, Mask b) { return _mm_and_pd(a.v, b.v); }
+static inline Mask operator|(Mask a, Mask b) { return _mm_or_pd(a.v, b.v); }
+static inline Mask operator~(Mask a) { return _mm_xor_pd(a.v, _mm_castsi128_pd(_mm_set1_epi32(-1))); }
+static inline Mask allLanes() { return _mm_castsi128_pd(_mm_set1_epi32(-1)); }
+static inline bool any(Mask a) { return _mm_movemask_pd(a.v) != 0; }
+static inline Real select(Mask mask, Real a, Real b) { return _mm_or_pd(_mm_and_pd(mask.v, a.v), _mm_andnot_pd(mask.v, b.v)); }
+
+#include "edge-kernels.hpp"
+
+}
+
+namespace sse2f {
+
+typedef float Scalar;
+static const int LANES = 4;
+
+struct Real {
+    __m128 v;
+    Real() { }
+    Real(__m128 v) : v(v) { }
+    explicit Real(float value) : v(_mm_set1_ps(value)) { }
+};
+
+struct Mask {
+    __m128 v;
+    Mask(__m128 v) : v(v) { }
+};
+
+static inline Real load(const float *p) { return _mm_loadu_ps(p); }
+static inline void store(float *p, Real a) { _mm_storeu_ps(p, a.v); }
+static inline Real operator+(Real a, Real b) { return _mm_add_ps(a.v, b.v); }
+static inline Real operator-(Real a, Real b) { return _mm_sub_ps(a.v, b.v); }
+static inline Real operator-(Real a) { return _mm_xor_ps(a.v, _mm_set1_ps(-0.f)); }
+static inline Real operator*(Real a, Real b) { return _mm_mul_ps(a.v, b.v); }
+static inline Real operator/(Real a, Real b) { return _mm_div_ps(a.v, b.v); }
+static inline Real sqrt(Real a) { return _mm_sqrt_ps(a.v); }
+static inline Real fabs(Real a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a.v); }
+static inline Mask operator<(Real a, Real b) { return _mm_cmplt_ps(a.v, b.v); }
+static inline Mask operator<=(Real a, Real b) { return _mm_cmple_ps(a.v, b.v); }
+static inline Mask operator>(Real a, Real b) { return _mm_cmpgt_ps(a.v, b.v); }
+static inline Mask operator>=(Real a, Real b) { return _mm_cmpge_ps(a.v, b.v); }
+static inline Mask operator==(Real a, Real b) { return _mm_cmpeq_ps(a.v, b.v); }
+static inline Mask operator&(Mask a, Mask b) { return _mm_and_ps(a.v, b.v); }
+static inline Mask operator|(Mask a, Mask b) { return _mm_or_ps(a.v, b.v); }
+static inline Mask operator~(Mask a) { return _mm_xor_ps(a.v, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+static inline Mask allLanes() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+static inline bool any(Mask a) { return _mm_movemask_ps(a.v) != 0; }
+static inline Real select(Mask mask, Real a, Real b) { return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)); }
+
+#include "edge-kernels.hpp"
+
+}
+
+// The AVX2 kernels are compiled for that instruction set regardless of the compiler flags and only called if the processor supports it
+#if defined(__clang__)
+    #pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+    #pragma GCC push_options
+    #pragma GCC target("avx2")
+#endif
+
+namespace avx2 {
+
+typedef double Scalar;
+static const int LANES = 4;
+
+struct Real {
+    __m256d v;
+    Real() { }
+    Real(__m256d v) : v(v) { }
+    explicit Real(double value) : v(_mm256_set1_pd(value)) { }
+};
+
+struct Mask {
+    __m256d v;
+    Mask(__m256d v) : v(v) { }
+};
+
+static inline Real load(const double *p) { return _mm256_loadu_pd(p); }
+static inline void store(double *p, Real a) { _mm256_storeu_pd(p, a.v); }
+static inline Real operator+(Real a, Real b) { return _mm256_add_pd(a.v, b.v); }
+static inline Real operator-(Real a, Real b) { return _mm256_sub_pd(a.v, b.v); }
+static inline Real operator-(Real a) { return _mm256_xor_pd(a.v, _mm256_set1_pd(-0.)); }
+static inline Real operator*(Real a, Real b) { return _mm256_mul_pd(a.v, b.v); }
+static inline Real operator/(Real a, Real b) { return _mm256_div_pd(a.v, b.v); }
+static inline Real sqrt(Real a) { return _mm256_sqrt_pd(a.v); }
+static inline Real fabs(Real a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.), a.v); }
+static inline Mask operator<(Real a, Real b) { return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ); }
+static inline Mask operator<=(Real a, Real b) { return _mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ); }
+static inline Mask operator>(Real a, Real b) { return _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ); }
+static inline Mask operator>=(Real a, Real b) { return _mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ); }
+static inline Mask operator==(Real a, Real b) { return _mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ); }
+static inline Mask operator&(Mask a, Mask b) { return _mm256_and_pd(a.v, b.v); }
+static inline Mask operator|(Mask a, Mask b) { return _mm256_or_pd(a.v, b.v); }
+static inline Mask operator~(Mask a) { return _mm256_xor_pd(a.v, _mm256_castsi256_pd(_mm256_set1_epi32(-1))); }
+static inline Mask allLanes() { return _mm256_castsi256_pd(_mm256_set1_epi32(-1)); }
+static inline bool any(Mask a) { return _mm256_movemask_pd(a.v) != 0; }
+static inline Real select(Mask mask, Real a, Real b) { return _mm256_blendv_pd(b.v, a.v, mask.v); }
+
+#include "edge-kernels.hpp"
+
+}
+
+namespace avx2f {
+
+typedef float Scalar;
+static const int LANES = 8;
+
+struct Real {
+    __m256 v;
+    Real() { }
+    Real(__m256 v) : v(v) { }
+    explicit Real(float value) : v(_mm256_set1_ps(value)) { }
+};
+
+struct Mask {
+    __m256 v;
+    Mask(__m256 v) : v(v) { }
+};
+
+static inline Real load(const float *p) { return _mm256_loadu_ps(p); }
+static inline void store(float *p, Real a) { _mm256_storeu_ps(p, a.v); }
+static inline Real operator+(Real a, Real b) { return _mm256_add_ps(a.v, b.v); }
+static inline Real operator-(Real a, Real b) { return _mm256_sub_ps(a.v, b.v); }
+static inline Real operator-(Real a) { return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.f)); }
+static inline Real operator*(Real a, Real b) { return _mm256_mul_ps(a.v, b.v); }
+static inline Real operator/(Real a, Real b) { return _mm256_div_ps(a.v, b.v); }
+static inline Real sqrt(Real a) { return _mm256_sqrt_ps(a.v); }
+static inline Real fabs(Real a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a.v); }
+static inline Mask operator<(Real a, Real b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+static inline Mask operator<=(Real a, Real b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ); }
+static inline Mask operator>(Real a, Real b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ); }
+static inline Mask operator>=(Real a, Real b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ); }
+static inline Mask operator==(Real a, Real b) { return _mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ); }
+static inline Mask operator&(Mask a, Mask b) { return _mm256_and_ps(a.v, b.v); }
+static inline Mask operator|(Mask a, Mask b) { return _mm256_or_ps(a.v, b.v); }
+static inline Mask operator~(Mask a) { return _mm256_xor_ps(a.v, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+static inline Mask allLanes() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+static inline bool any(Mask a) { return _mm256_movemask_ps(a.v) != 0; }
+static inline Real select(Mask mask, Real a, Real b) { return _mm256_blendv_ps(b.v, a.v, mask.v); }
+
+#include "edge-kernels.hpp"
+
+}
+
+#if defined(__clang__)
+    #pragma clang attribute pop
+#elif defined(__GNUC__)
+    #pragma GCC pop_options
+#endif
+
+static bool supportsAvx2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    // The operating system must save the YMM registers
+    if (!(info[2]&(1<<27)) || !(info[2]&(1<<28)) || (_xgetbv(0)&6) != 6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1]&(1<<5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif
+
+#ifdef MSDFGEN_SIMD_NEON
+
+namespace neon {
+
+typedef double Scalar;
+static const int LANES = 2;
+
+struct Real {
+    float64x2_t v;
+    Real() { }
+    Real(float64x2_t v) : v(v) { }
+    explicit Real(double value) : v(vdupq_n_f64(value)) { }
+};
+
+struct Mask {
+    uint64x2_t v;
+    Mask(uint64x2_t v) : v(v) { }
+};
+
+static inline Real load(const double *p) { return vld1q_f64(p); }
+static inline void store(double *p, Real a) { vst1q_f64(p, a.v); }
+static inline Real operator+(Real a, Real b) { return vaddq_f64(a.v, b.v); }
+static inline Real operator-(Real a, Real b) { return vsubq_f64(a.v, b.v); }
+static inline Real operator-(Real a) { return vnegq_f64(a.v); }
+static inline Real operator*(Real a, Real b) { return vmulq_f64(a.v, b.v); }
+static inline Real operator/(Real a, Real b) { return vdivq_f64(a.v, b.v); }
+static inline Real sqrt(Real a) { return vsqrtq_f64(a.v); }
+static inline Real fabs(Real a) { return vabsq_f64(a.v); }
+static inline Mask operator<(Real a, Real b) { return vcltq_f64(a.v, b.v); }
+static inline Mask operator<=(Real a, Real b) { return vcleq_f64(a.v, b.v); }
+static inline Mask operator>(Real a, Real b) { return vcgtq_f64(a.v, b.v); }
+static inline Mask operator>=(Real a, Real b) { return vcgeq_f64(a.v, b.v); }
+static inline Mask operator==(Real a, Real b) { return vceqq_f64(a.v, b.v); }
+static inline Mask operator&(Mask a, Mask b) { return vandq_u64(a.v, b.v); }
+static inline Mask operator|(Mask a, Mask b) { return vorrq_u64(a.v, b.v); }
+static inline Mask operator~(Mask a) { return veorq_u64(a.v, vdupq_n_u64(~0ull)); }
+static inline Mask allLanes() { return vdupq_n_u64(~0ull); }
+static inline bool any(Mask a) { return (vgetq_lane_u64(a.v, 0)|vgetq_lane_u64(a.v, 1)) != 0; }
+static inline Real select(Mask mask, Real a, Real b) { return vbslq_f64(mask.v, a.v, b.v); }
+
+#include "edge-kernels.hpp"
+
+}
+
+namespace neonf {
+
+typedef float Scalar;
+static const int LANES = 4;
+
+struct Real {
+    float32x4_t v;
+    Real() { }
+    Real(float32x4_t v) : v(v) { }
+    explicit Real(float value) : v(vdupq_n_f32(value)) { }
+};
+
+struct Mask {
+    uint32x4_t v;
+    Mask(uint32x4_t v) : v(v) { }
+};
+
+static inline Real load(const float *p) { return vld1q_f32(p); }
+static inline void store(float *p, Real a) { vst1q_f32(p, a.v); }
+static inline Real operator+(Real a, Real b) { return vaddq_f32(a.v, b.v); }
+static inline Real operator-(Real a, Real b) { return vsubq_f32(a.v, b.v); }
+static inline Real operator-(Real a) { return vnegq_f32(a.v); }
+static inline Real operator*(Real a, Real b) { return vmulq_f32(a.v, b.v); }
+static inline Real operator/(Real a, Real b) { return vdivq_f32(a.v, b.v); }
+static inline Real sqrt(Real a) { return vsqrtq_f32(a.v); }
+static inline Real fabs(Real a) { return vabsq_f32(a.v); }
+static inline Mask operator<(Real a, Real b) { return vcltq_f32(a.v, b.v); }
+static inline Mask operator<=(Real a, Real b) { return vcleq_f32(a.v, b.v); }
+static inline Mask operator>(Real a, Real b) { return vcgtq_f32(a.v, b.v); }
+static inline Mask operator>=(Real a, Real b) { return vcgeq_f32(a.v, b.v); }
+static inline Mask operator==(Real a, Real b) { return vceqq_f32(a.v, b.v); }
+static inline Mask operator&(Mask a, Mask b) { return vandq_u32(a.v, b.v); }
+static inline Mask operator|(Mask a, Mask b) { return vorrq_u32(a.v, b.v); }
+static inline Mask operator~(Mask a) { return vmvnq_u32(a.v); }
+static inline Mask allLanes() { return vdupq_n_u32(~0u); }
+static inline bool any(Mask a) { return vmaxvq_u32(a.v) != 0; }
+static inline Real select(Mask mask, Real a, Real b) { return vbslq_f32(mask.v, a.v, b.v); }
+
+#include "edge-kernels.hpp"
+
+}
+
+#endif
+
+#define MSDFGEN_SET_KERNELS(kernels, simdLevel, ns) ( \
+    (kernels).level = (simdLevel), \
+    (kernels).linear = &ns::linearSignedDistance, \
+    (kernels).quadratic = &ns::quadraticSignedDistance, \
+    (kernels).cubic = &ns::cubicSignedDistance \
+)
+
+SimdLevel detectSimdLevel() {
+#if defined(MSDFGEN_SIMD_X86)
+    return supportsAvx2() ? SIMD_AVX2 : SIMD_SSE2;
+#elif defined(MSDFGEN_SIMD_NEON)
+    return SIMD_NEON;
+#else
+    return SIMD_NONE;
+#endif
+}
+
+// Statically initialized to the scalar kernels, so that they are valid even before the instruction set is detected
+static EdgeKernels edgeKernels = { SIMD_NONE, &scalar::linearSignedDistance, &scalar::quadraticSignedDistance, &scalar::cubicSignedDistance };
+static EdgeKernelsT<float> floatEdgeKernels = { SIMD_NONE, &scalarf::linearSignedDistance, &scalarf::quadraticSignedDistance, &scalarf::cubicSignedDistance };
+
+static const EdgeKernels & currentKernels(double) {
+    return edgeKernels;
+}
+
+static const EdgeKernelsT<float> & currentKernels(float) {
+    return floatEdgeKernels;
+}
+
+template <typename T>
+const EdgeKernelsT<T> & getEdgeKernels() {
+    return currentKernels(T());
+}
+
+template const EdgeKernels & getEdgeKernels<double>();
+template const EdgeKernelsT<float> & getEdgeKernels<float>();
+
+void setSimdLevel(SimdLevel level) {
+    SimdLevel supported = detectSimdLevel();
+    bool available = level == SIMD_NONE || level == supported || (supported == SIMD_AVX2 && level == SIMD_SSE2);
+    switch (available ? level : supported) {
+#ifdef MSDFGEN_SIMD_X86
+        case SIMD_AVX2:
+            MSDFGEN_SET_KERNELS(edgeKernels, SIMD_AVX2, avx2);
+            MSDFGEN_SET_KERNELS(floatEdgeKernels, SIMD_AVX2, avx2f);
+            break;
+        case SIMD_SSE2:
+            MSDFGEN_SET_KERNELS(edgeKernels, SIMD_SSE2, sse2);
+            MSDFGEN_SET_KERNELS(floatEdgeKernels, SIMD_SSE2, sse2f);
+            break;
+#endif
+#ifdef MSDFGEN_SIMD_NEON
+        case SIMD_NEON:
+            MSDFGEN_SET_KERNELS(edgeKernels, SIMD_NEON, neon);
+            MSDFGEN_SET_KERNELS(floatEdgeKernels, SIMD_NEON, neonf);
+            break;
+#endif
+        default:
+            MSDFGEN_SET_KERNELS(edgeKernels, SIMD_NONE, scalar);
+            MSDFGEN_SET_KERNELS(floatEdgeKernels, SIMD_NONE, scalarf);
+    }
+}
+
+static const bool simdLevelDetected = (setSimdLevel(detectSimdLevel()), true);
+
+}
@@ -0,0 +1,188 @@
+
+// Batch signed distance kernels, written once in terms of the lane types Real and Mask.
+// This file is included by edge-kernels.cpp once per instruction set and precision, inside a namespace that defines
+// Scalar, Real, Mask, LANES and the basic operations on them. Every operation is performed in the same order
+// as in the scalar implementation in edge-segments.cpp, so that both produce bit-identical results.
+
+/// A vector with one component per lane.
+struct Vec2 {
+    Real x, y;
+
+    Vec2() { }
+    Vec2(Real x, Real y) : x(x), y(y) { }
+    explicit Vec2(const Vector2T<Scalar> &v) : x(v.x), y(v.y) { }
+};
+
+static inline Vec2 operator+(const Vec2 &a, const Vec2 &b) {
+    return Vec2(a.x+b.x, a.y+b.y);
+}
+
+static inline Vec2 operator-(const Vec2 &a, const Vec2 &b) {
+    return Vec2(a.x-b.x, a.y-b.y);
+}
+
+static inline Vec2 operator*(Real value, const Vec2 &vector) {
+    return Vec2(value*vector.x, value*vector.y);
+}
+
+static inline Vec2 operator*(const Vec2 &vector, Real value) {
+    return Vec2(vector.x*value, vector.y*value);
+}
+
+static inline Real dotProduct(const Vec2 &a, const Vec2 &b) {
+    return a.x*b.x+a.y*b.y;
+}
+
+static inline Real crossProduct(const Vec2 &a, const Vec2 &b) {
+    return a.x*b.y-a.y*b.x;
+}
+
+static inline Real length(const Vec2 &v) {
+    return sqrt(v.x*v.x+v.y*v.y);
+}
+
+static inline Vec2 normalize(const Vec2 &v) {
+    Real len = length(v);
+    Mask zero = len == Real(0.);
+    return Vec2(select(zero, Real(0.), v.x/len), select(zero, Real(1.), v.y/len));
+}
+
+static inline Vec2 select(Mask mask, const Vec2 &a, const Vec2 &b) {
+    return Vec2(select(mask, a.x, b.x), select(mask, a.y, b.y));
+}
+
+static inline Vec2 mix(const Vec2 &a, const Vec2 &b, Real weight) {
+    return (Real(1.)-weight)*a+weight*b;
+}
+
+static inline Real nonZeroSign(Real n) {
+    return select(n > Real(0.), Real(1.), Real(-1.));
+}
+
+static inline void storeResults(Real distance, Real dot, Real param, SignedDistanceT<Scalar> *distanceOut, Scalar *paramOut) {
+    Scalar d[LANES], t[LANES];
+    store(d, distance);
+    store(t, dot);
+    store(paramOut, param);
+    for (int i = 0; i < LANES; ++i)
+        distanceOut[i] = SignedDistanceT<Scalar>(d[i], t[i]);
+}
+
+static void linearSignedDistance(const CompiledLinearSegmentT<Scalar> &segment, const Scalar *x, const Scalar *y, SignedDistanceT<Scalar> *distance, Scalar *param) {
+    Vec2 p0(segment.p[0]), p1(segment.p[1]), ab(segment.ab);
+    Vec2 orthonormal(segment.orthonormal), direction(segment.direction);
+    Real abLengthSquared(segment.abLengthSquared);
+    for (int i = 0; i < CompiledShapeT<Scalar>::BATCH_SIZE; i += LANES) {
+        Vec2 origin(load(x+i), load(y+i));
+        Vec2 aq = origin-p0;
+        Real t = dotProduct(aq, ab)/abLengthSquared;
+        Vec2 eq = select(t > Real(.5), p1-origin, p0-origin);
+        Real endpointDistance = length(eq);
+        Real orthoDistance = dotProduct(orthonormal, aq);
+        Mask ortho = (t > Real(0.))&(t < Real(1.))&(fabs(orthoDistance) < endpointDistance);
+        storeResults(
+            select(ortho, orthoDistance, nonZeroSign(crossProduct(aq, ab))*endpointDistance),
+            select(ortho, Real(0.), fabs(dotProduct(direction, normalize(eq)))),
+            t, distance+i, param+i
+        );
+    }
+}
+
+static void quadraticSignedDistance(const CompiledQuadraticSegmentT<Scalar> &segment, const Scalar *x, const Scalar *y, SignedDistanceT<Scalar> *distance, Scalar *param) {
+    Vec2 p0(segment.p[0]), p1(segment.p[1]), p2(segment.p[2]);
+    Vec2 ab(segment.ab), br(segment.br), bc(segment.bc), ac(segment.ac);
+    Vec2 startDirection(segment.startDirection), endDirection(segment.endDirection);
+    Real c0(segment.c0), abLengthSquared(segment.abLengthSquared), bcLengthSquared(segment.bcLengthSquared);
+    for (int i = 0; i < CompiledShapeT<Scalar>::BATCH_SIZE; i += LANES) {
+        Vec2 origin(load(x+i), load(y+i));
+        Vec2 qa = p0-origin;
+        Scalar c[LANES], d[LANES];
+        store(c, c0+dotProduct(qa, br));
+        store(d, dotProduct(qa, ab));
+        // The cubic equation is solved separately for each lane, missing roots are marked by NaN.
+        // It is always solved in double precision, since single precision fails for nearly straight curves.
+        Scalar roots[3][LANES];
+        for (int lane = 0; lane < LANES; ++lane) {
+            double t[3];
+            int solutions = solveCubic<double>(t, segment.a, segment.b, c[lane], d[lane]);
+            for (int j = 0; j < 3; ++j)
+                roots[j][lane] = j < solutions ? Scalar(t[j]) : std::numeric_limits<Scalar>::quiet_NaN();
+        }
+
+        Real minDistance = nonZeroSign(crossProduct(ab, qa))*length(qa);
+        Real t = -dotProduct(qa, ab)/abLengthSquared;
+        Vec2 cq = p2-origin;
+        {
+            Real distance = nonZeroSign(crossProduct(bc, cq))*length(cq);
+            Mask closer = fabs(distance) < fabs(minDistance);
+            minDistance = select(closer, distance, minDistance);
+            t = select(closer, dotProduct(origin-p1, bc)/bcLengthSquared, t);
+        }
+        for (int j = 0; j < 3; ++j) {
+            Real root = load(roots[j]);
+            Mask inside = (root > Real(0.))&(root < Real(1.));
+            if (!any(inside))
+                continue;
+            Vec2 endpoint = p0+(Real(2.)*root)*ab+(root*root)*br;
+            Real distance = nonZeroSign(crossProduct(ac, endpoint-origin))*length(endpoint-origin);
+            Mask closer = inside&(fabs(distance) <= fabs(minDistance));
+            minDistance = select(closer, distance, minDistance);
+            t = select(closer, root, t);
+        }
+
+        Mask onSegment = (t >= Real(0.))&(t <= Real(1.));
+        Real startDot = fabs(dotProduct(startDirection, normalize(qa)));
+        Real endDot = fabs(dotProduct(endDirection, normalize(cq)));
+        storeResults(minDistance, select(onSegment, Real(0.), select(t < Real(.5), startDot, endDot)), t, distance+i, param+i);
+    }
+}
+
+static void cubicSignedDistance(const CompiledCubicSegmentT<Scalar> &segment, const Scalar *x, const Scalar *y, SignedDistanceT<Scalar> *distance, Scalar *param) {
+    Vec2 p0(segment.p[0]), p1(segment.p[1]), p2(segment.p[2]), p3(segment.p[3]);
+    Vec2 ab(segment.ab), bc(segment.bc), cd(segment.cd);
+    Vec2 ab3(segment.ab3), br6(segment.br6), as3(segment.as3), as6(segment.as6);
+    Vec2 startDirection(segment.startDirection), endDirection(segment.endDirection);
+    Real abLengthSquared(segment.abLengthSquared), cdLengthSquared(segment.cdLengthSquared);
+    for (int i = 0; i < CompiledShapeT<Scalar>::BATCH_SIZE; i += LANES) {
+        Vec2 origin(load(x+i), load(y+i));
+        Vec2 qa = p0-origin;
+
+        Real minDistance = nonZeroSign(crossProduct(ab, qa))*length(qa);
+        Real t = -dotProduct(qa, ab)/abLengthSquared;
+        Vec2 dq = p3-origin;
+        {
+            Real distance = nonZeroSign(crossProduct(cd, dq))*length(dq);
+            Mask closer = fabs(distance) < fabs(minDistance);
+            minDistance = select(closer, distance, minDistance);
+            t = select(closer, dotProduct(origin-p2, cd)/cdLengthSquared, t);
+        }
+        // Iterative minimum distance search, lanes drop out as their parameter leaves the curve
+        for (int start = 0; start <= MSDFGEN_CUBIC_SEARCH_STARTS; ++start) {
+            Real u(Scalar(start)/MSDFGEN_CUBIC_SEARCH_STARTS);
+            Mask active = allLanes();
+            for (int step = 0;; ++step) {
+                Vec2 p12 = mix(p1, p2, u);
+                Vec2 qpt = mix(mix(mix(p0, p1, u), p12, u), mix(p12, mix(p2, p3, u), u), u)-origin;
+                Vec2 direction = mix(mix(ab, bc, u), mix(bc, cd, u), u);
+                Real distance = nonZeroSign(crossProduct(direction, qpt))*length(qpt);
+                Mask closer = active&(fabs(distance) < fabs(minDistance));
+                minDistance = select(closer, distance, minDistance);
+                t = select(closer, u, t);
+                if (step == MSDFGEN_CUBIC_SEARCH_STEPS)
+                    break;
+                // Improve u
+                Vec2 firstDerivative = as3*u*u+br6*u+ab3;
+                Vec2 secondDerivative = as6*u+br6;
+                u = u-dotProduct(qpt, firstDerivative)/(dotProduct(firstDerivative, firstDerivative)+dotProduct(qpt, secondDerivative));
+                active = active&~((u < Real(0.))|(u > Real(1.)));
+                if (!any(active))
+                    break;
+            }
+        }
+
+        Mask onSegment = (t >= Real(0.))&(t <= Real(1.));
+        Real startDot = fabs(dotProduct(startDirection, normalize(qa)));
+        Real endDot = fabs(dotProduct(endDirection, normalize(dq)));
+        storeResults(minDistance, select(onSegment, Real(0.), select(t < Real(.5), startDot, endDot)), t, distance+i, param+i);
+    }
+}
@@ -1,11 +1,23 @@
 
 #include "msdfgen/core/edge-segments.h"
 
+#include <algorithm>
+
 #include "msdfgen/core/arithmetics.hpp"
 #include "msdfgen/core/equation-solver.h"
+#include "msdfgen/core/edge-kernels.h"
+#include "msdfgen/core/EdgeArena.h"
 
 namespace msdfgen {
 
+void * EdgeSegment::operator new(size_t size) {
+    return EdgeArena::allocate(size);
+}
+
+void EdgeSegment::operator delete(void *ptr) {
+    EdgeArena::deallocate(ptr);
+}
+
 void EdgeSegment::distanceToPseudoDistance(SignedDistance &distance, Point2 origin, double param) const {
     if (param < 0) {
         Vector2 dir = direction(0).normalize();
@@ -32,6 +44,11 @@ void EdgeSegment::distanceToPseudoDistance(SignedDistance &distance, Point2 orig
     }
 }
 
+void EdgeSegment::signedDistanceBatch(const double *x, const double *y, SignedDistance *distance, double *param) const {
+    for (int i = 0; i < MSDFGEN_BATCH_SIZE; ++i)
+        distance[i] = signedDistance(Point2(x[i], y[i]), param[i]);
+}
+
 LinearSegment::LinearSegment(Point2 p0, Point2 p1, EdgeColor edgeColor) : EdgeSegment(edgeColor) {
     p[0] = p0;
     p[1] = p1;
@@ -87,6 +104,18 @@ Vector2 CubicSegment::direction(double param) const {
     return mix(mix(p[1]-p[0], p[2]-p[1], param), mix(p[2]-p[1], p[3]-p[2], param), param);
 }
 
+void LinearSegment::signedDistanceBatch(const double *x, const double *y, SignedDistance *distance, double *param) const {
+    getEdgeKernels<double>().linear(CompiledLinearSegment(p), x, y, distance, param);
+}
+
+void QuadraticSegment::signedDistanceBatch(const double *x, const double *y, SignedDistance *distance, double *param) const {
+    getEdgeKernels<double>().quadratic(CompiledQuadraticSegment(p), x, y, distance, param);
+}
+
+void CubicSegment::signedDistanceBatch(const double *x, const double *y, SignedDistance *distance, double *param) const {
+    getEdgeKernels<double>().cubic(CompiledCubicSegment(p), x, y, distance, param);
+}
+
 SignedDistance LinearSegment::signedDistance(Point2 origin, double &param) const {
     Vector2 aq = origin-p[0];
     Vector2 ab = p[1]-p[0];
@@ -235,6 +264,88 @@ static void pointBounds(Point2 p, double &l, double &b, double &r, double &t) {
     if (p.y > t) t = p.y;
 }
 
+/// Finds the crossings of a curve with the horizontal line at y. The parameters split the curve into parts along which y is monotonic,
+/// so that each part crosses the line at most once, and the crossing is found by the Illinois variant of the false position method.
+static int monotonicCrossings(const EdgeSegment &edge, const double *params, int paramCount, double x[3], int dy[3], double y) {
+    int count = 0;
+    double prevParam = 0;
+    double prevHeight = edge.point(0).y-y;
+    for (int i = 0; i <= paramCount; ++i) {
+        double param = i < paramCount ? params[i] : 1;
+        double height = edge.point(param).y-y;
+        bool prevAbove = prevHeight > 0, above = height > 0;
+        if (above != prevAbove) {
+            // The line is crossed between a and b, the heights of the curve above the line there are fa and fb
+            double a = prevParam, b = param, fa = prevHeight, fb = height;
+            int side = 0;
+            for (int step = 0; step < 64 && b-a > 1e-15; ++step) {
+                double t = (a*fb-b*fa)/(fb-fa);
+                if (!(t > a && t < b))
+                    t = .5*(a+b);
+                double ft = edge.point(t).y-y;
+                if ((ft > 0) == prevAbove) {
+                    a = t, fa = ft;
+                    if (side < 0)
+                        fb *= .5;
+                    side = -1;
+                } else {
+                    b = t, fb = ft;
+                    if (side > 0)
+                        fa *= .5;
+                    side = 1;
+                }
+                if (ft == 0)
+                    break;
+            }
+            x[count] = edge.point(fabs(fa) < fabs(fb) ? a : b).x;
+            dy[count] = above ? 1 : -1;
+            ++count;
+        }
+        prevParam = param, prevHeight = height;
+    }
+    return count;
+}
+
+int LinearSegment::scanlineIntersections(double x[3], int dy[3], double y) const {
+    bool startAbove = p[0].y > y, endAbove = p[1].y > y;
+    if (startAbove == endAbove)
+        return 0;
+    x[0] = p[0].x+(y-p[0].y)/(p[1].y-p[0].y)*(p[1].x-p[0].x);
+    dy[0] = endAbove ? 1 : -1;
+    return 1;
+}
+
+int QuadraticSegment::scanlineIntersections(double x[3], int dy[3], double y) const {
+    if ((p[0].y > y) == (p[1].y > y) && (p[1].y > y) == (p[2].y > y))
+        return 0;
+    double params[1];
+    int paramCount = 0;
+    double bot = (p[1].y-p[0].y)-(p[2].y-p[1].y);
+    if (bot) {
+        double param = (p[1].y-p[0].y)/bot;
+        if (param > 0 && param < 1)
+            params[paramCount++] = param;
+    }
+    return monotonicCrossings(*this, params, paramCount, x, dy, y);
+}
+
+int CubicSegment::scanlineIntersections(double x[3], int dy[3], double y) const {
+    if ((p[0].y > y) == (p[1].y > y) && (p[1].y > y) == (p[2].y > y) && (p[2].y > y) == (p[3].y > y))
+        return 0;
+    double a0 = p[1].y-p[0].y;
+    double a1 = 2*(p[2].y-p[1].y-a0);
+    double a2 = p[3].y-3*p[2].y+3*p[1].y-p[0].y;
+    double roots[2], params[2];
+    int solutions = solveQuadratic(roots, a2, a1, a0);
+    int paramCount = 0;
+    for (int i = 0; i < solutions; ++i)
+        if (roots[i] > 0 && roots[i] < 1)
+            params[paramCount++] = roots[i];
+    if (paramCount == 2 && params[0] > params[1])
+        std::swap(params[0], params[1]);
+    return monotonicCrossings(*this, params, paramCount, x, dy, y);
+}
+
 void LinearSegment::bounds(double &l, double &b, double &r, double &t) const {
     pointBounds(p[0], l, b, r, t);
     pointBounds(p[1], l, b, r, t);
@@ -1,107 +1,353 @@
 
 #include "msdfgen/core/render-sdf.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <vector>
 #include "msdfgen/core/arithmetics.hpp"
 
+#if defined(__x86_64__) || defined(_M_X64)
+    #define MSDFGEN_SIMD_X86
+    #include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define MSDFGEN_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+// Number of output rows each part of a parallel render covers, so that source rows are reused between adjacent output rows.
+#define RENDER_BAND_ROWS 16
+
 namespace msdfgen {
 
-template <typename S>
-inline FloatRGB mix(FloatRGB a, FloatRGB b, S weight) {
-    FloatRGB output = {
-        mix(a.r, b.r, weight),
-        mix(a.g, b.g, weight),
-        mix(a.b, b.b, weight)
-    };
-    return output;
+/// Computes output = mix(a, b, weight) for n values.
+static void mixValues(float *output, const float *a, const float *b, float weight, int n) {
+    int i = 0;
+#if defined(MSDFGEN_SIMD_X86)
+    __m128 wa = _mm_set1_ps(1.f-weight), wb = _mm_set1_ps(weight);
+    for (; i+4 <= n; i += 4)
+        _mm_storeu_ps(output+i, _mm_add_ps(_mm_mul_ps(wa, _mm_loadu_ps(a+i)), _mm_mul_ps(wb, _mm_loadu_ps(b+i))));
+#elif defined(MSDFGEN_SIMD_NEON)
+    float32x4_t wa = vdupq_n_f32(1.f-weight), wb = vdupq_n_f32(weight);
+    for (; i+4 <= n; i += 4)
+        vst1q_f32(output+i, vaddq_f32(vmulq_f32(wa, vld1q_f32(a+i)), vmulq_f32(wb, vld1q_f32(b+i))));
+#endif
+    for (; i < n; ++i)
+        output[i] = mix(a[i], b[i], weight);
 }
 
-template <typename T>
-static T sample(const Bitmap<T> &bitmap, Point2 pos) {
-    int w = bitmap.width(), h = bitmap.height();
-    double x = pos.x*w-.5;
-    double y = pos.y*h-.5;
-    int l = (int) floor(x);
-    int b = (int) floor(y);
-    int r = l+1;
-    int t = b+1;
-    double lr = x-l;
-    double bt = y-b;
-    l = clamp(l, w-1), r = clamp(r, w-1);
-    b = clamp(b, h-1), t = clamp(t, h-1);
-    return mix(mix(bitmap(l, b), bitmap(r, b), lr), mix(bitmap(l, t), bitmap(r, t), lr), bt);
-}
-
-static float distVal(float dist, double pxRange) {
-    if (!pxRange)
-        return dist > .5;
-    return (float) clamp((dist-.5)*pxRange+.5);
-}
-
-void renderSDF(Bitmap<float> &output, const Bitmap<float> &sdf, double pxRange) {
-    int w = output.width(), h = output.height();
-    pxRange *= (double) (w+h)/(sdf.width()+sdf.height());
-    for (int y = 0; y < h; ++y)
-        for (int x = 0; x < w; ++x) {
-            float s = sample(sdf, Point2((x+.5)/w, (y+.5)/h));
-            output(x, y) = distVal(s, pxRange);
+/// Computes output = median(r, g, b) for n values.
+static void medianValues(float *output, const float *r, const float *g, const float *b, int n) {
+    int i = 0;
+#if defined(MSDFGEN_SIMD_X86)
+    for (; i+4 <= n; i += 4) {
+        __m128 vr = _mm_loadu_ps(r+i), vg = _mm_loadu_ps(g+i), vb = _mm_loadu_ps(b+i);
+        _mm_storeu_ps(output+i, _mm_max_ps(_mm_min_ps(vr, vg), _mm_min_ps(_mm_max_ps(vr, vg), vb)));
+    }
+#elif defined(MSDFGEN_SIMD_NEON)
+    for (; i+4 <= n; i += 4) {
+        float32x4_t vr = vld1q_f32(r+i), vg = vld1q_f32(g+i), vb = vld1q_f32(b+i);
+        vst1q_f32(output+i, vmaxq_f32(vminq_f32(vr, vg), vminq_f32(vmaxq_f32(vr, vg), vb)));
+    }
+#endif
+    for (; i < n; ++i)
+        output[i] = median(r[i], g[i], b[i]);
+}
+
+/// Converts n signed distances to the opacity of the shape, which is a step at .5 if pxRange is zero.
+static void distanceValues(float *values, int n, float pxRange) {
+    int i = 0;
+    if (!pxRange) {
+#if defined(MSDFGEN_SIMD_X86)
+        __m128 half = _mm_set1_ps(.5f), one = _mm_set1_ps(1.f);
+        for (; i+4 <= n; i += 4)
+            _mm_storeu_ps(values+i, _mm_and_ps(_mm_cmpgt_ps(_mm_loadu_ps(values+i), half), one));
+#elif defined(MSDFGEN_SIMD_NEON)
+        float32x4_t half = vdupq_n_f32(.5f), one = vdupq_n_f32(1.f);
+        for (; i+4 <= n; i += 4)
+            vst1q_f32(values+i, vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(vld1q_f32(values+i), half), vreinterpretq_u32_f32(one))));
+#endif
+        for (; i < n; ++i)
+            values[i] = float(values[i] > .5f);
+        return;
+    }
+#if defined(MSDFGEN_SIMD_X86)
+    __m128 half = _mm_set1_ps(.5f), range = _mm_set1_ps(pxRange), zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f);
+    for (; i+4 <= n; i += 4) {
+        __m128 v = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(values+i), half), range), half);
+        _mm_storeu_ps(values+i, _mm_min_ps(_mm_max_ps(v, zero), one));
+    }
+#elif defined(MSDFGEN_SIMD_NEON)
+    float32x4_t half = vdupq_n_f32(.5f), range = vdupq_n_f32(pxRange), zero = vdupq_n_f32(0.f), one = vdupq_n_f32(1.f);
+    for (; i+4 <= n; i += 4) {
+        float32x4_t v = vaddq_f32(vmulq_f32(vsubq_f32(vld1q_f32(values+i), half), range), half);
+        vst1q_f32(values+i, vminq_f32(vmaxq_f32(v, zero), one));
+    }
+#endif
+    for (; i < n; ++i)
+        values[i] = clamp((values[i]-.5f)*pxRange+.5f);
+}
+
+/// Snaps n values to the nearest lower multiple of 1/255 the same way as storing them in 8 bits.
+static void quantizeValues(float *values, int n) {
+    int i = 0;
+#if defined(MSDFGEN_SIMD_X86)
+    __m128 scale = _mm_set1_ps(256.f), zero = _mm_setzero_ps(), maxValue = _mm_set1_ps(255.f);
+    for (; i+4 <= n; i += 4) {
+        __m128 v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(values+i), scale), zero), maxValue);
+        _mm_storeu_ps(values+i, _mm_div_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(v)), maxValue));
+    }
+#elif defined(MSDFGEN_SIMD_NEON)
+    float32x4_t scale = vdupq_n_f32(256.f), zero = vdupq_n_f32(0.f), maxValue = vdupq_n_f32(255.f);
+    for (; i+4 <= n; i += 4) {
+        float32x4_t v = vminq_f32(vmaxq_f32(vmulq_f32(vld1q_f32(values+i), scale), zero), maxValue);
+        vst1q_f32(values+i, vdivq_f32(vcvtq_f32_s32(vcvtq_s32_f32(v)), maxValue));
+    }
+#endif
+    for (; i < n; ++i) {
+        unsigned char v = clamp(int(values[i]*0x100), 0xff);
+        values[i] = v/255.f;
+    }
+}
+
+/// Positions of the source pixels that bilinear sampling mixes along one axis, for each output pixel.
+struct SampleAxis {
+    std::vector<int> low, high;
+    std::vector<float> weight;
+
+    SampleAxis(int outputSize, int sourceSize) : low(outputSize), high(outputSize), weight(outputSize) {
+        for (int i = 0; i < outputSize; ++i) {
+            double x = (i+.5)/outputSize*sourceSize-.5;
+            int l = (int) floor(x);
+            weight[i] = float(x-l);
+            low[i] = clamp(l, sourceSize-1);
+            high[i] = clamp(l+1, sourceSize-1);
         }
+    }
+};
+
+/// Reads the rows of a floating-point distance field into separate channels.
+template <typename T>
+class BitmapSource {
+
+public:
+    explicit BitmapSource(const Bitmap<T> &bitmap) : bitmap(bitmap) { }
+    int width() const { return bitmap.width(); }
+    int height() const { return bitmap.height(); }
+    int channels() const;
+    void readRow(float *const *planes, int y) const;
+
+private:
+    const Bitmap<T> &bitmap;
+
+};
+
+template <>
+int BitmapSource<float>::channels() const {
+    return 1;
 }
 
-void renderSDF(Bitmap<FloatRGB> &output, const Bitmap<float> &sdf, double pxRange) {
-    int w = output.width(), h = output.height();
-    pxRange *= (double) (w+h)/(sdf.width()+sdf.height());
-    for (int y = 0; y < h; ++y)
-        for (int x = 0; x < w; ++x) {
-            float s = sample(sdf, Point2((x+.5)/w, (y+.5)/h));
-            float v = distVal(s, pxRange);
-            output(x, y).r = v;
-            output(x, y).g = v;
-            output(x, y).b = v;
+template <>
+void BitmapSource<float>::readRow(float *const *planes, int y) const {
+    for (int x = 0; x < bitmap.width(); ++x)
+        planes[0][x] = bitmap(x, y);
+}
+
+template <>
+int BitmapSource<FloatRGB>::channels() const {
+    return 3;
+}
+
+template <>
+void BitmapSource<FloatRGB>::readRow(float *const *planes, int y) const {
+    for (int x = 0; x < bitmap.width(); ++x) {
+        const FloatRGB &pixel = bitmap(x, y);
+        planes[0][x] = pixel.r;
+        planes[1][x] = pixel.g;
+        planes[2][x] = pixel.b;
+    }
+}
+
+/// Reads the rows of an 8-bit distance field into separate channels.
+class ByteSource {
+
+public:
+    explicit ByteSource(const ByteBitmapConstRef &bitmap) : bitmap(bitmap) { }
+    int width() const { return bitmap.width; }
+    int height() const { return bitmap.height; }
+    int channels() const { return bitmap.channels >= 3 ? 3 : 1; }
+    void readRow(float *const *planes, int y) const {
+        const unsigned char *row = bitmap.pixels+(ptrdiff_t) y*bitmap.rowStride;
+        int channelCount = channels();
+        for (int c = 0; c < channelCount; ++c) {
+            const unsigned char *pixel = row+c;
+            float *plane = planes[c];
+            if (bitmap.invert) {
+                for (int x = 0; x < bitmap.width; ++x, pixel += bitmap.pixelStride)
+                    plane[x] = 1.f-*pixel/255.f;
+            } else {
+                for (int x = 0; x < bitmap.width; ++x, pixel += bitmap.pixelStride)
+                    plane[x] = *pixel/255.f;
+            }
         }
+    }
+
+private:
+    const ByteBitmapConstRef &bitmap;
+
+};
+
+static void storeRow(Bitmap<float> &output, int y, float *const *planes, int /*channels*/) {
+    for (int x = 0; x < output.width(); ++x)
+        output(x, y) = planes[0][x];
 }
 
-void renderSDF(Bitmap<float> &output, const Bitmap<FloatRGB> &sdf, double pxRange) {
-    int w = output.width(), h = output.height();
-    pxRange *= (double) (w+h)/(sdf.width()+sdf.height());
-    for (int y = 0; y < h; ++y)
-        for (int x = 0; x < w; ++x) {
-            FloatRGB s = sample(sdf, Point2((x+.5)/w, (y+.5)/h));
-            output(x, y) = distVal(median(s.r, s.g, s.b), pxRange);
+static void storeRow(Bitmap<FloatRGB> &output, int y, float *const *planes, int channels) {
+    const float *g = planes[channels == 3 ? 1 : 0], *b = planes[channels == 3 ? 2 : 0];
+    for (int x = 0; x < output.width(); ++x)
+        output(x, y) = FloatRGB(planes[0][x], g[x], b[x]);
+}
+
+/// Renders a band of output rows. Each part samples the source rows it needs into its own buffers and processes whole rows at once,
+/// mixing the two source rows, then sampling the columns and converting the distances.
+template <class Output, class Source>
+class RenderSDFTask : public ParallelTask {
+
+public:
+    RenderSDFTask(Output &output, const Source &source, bool singleChannelOutput, float pxRange, const SampleAxis &x, const SampleAxis &y) :
+        output(output), source(source), singleChannelOutput(singleChannelOutput), pxRange(pxRange), x(x), y(y) { }
+    void run(int band) {
+        int width = output.width(), sourceWidth = source.width();
+        int channels = source.channels();
+        // Source rows low and high, their mix, and the sampled output row, each with a plane per channel
+        std::vector<float> buffer(3*(3*sourceWidth+width));
+        float *lowRow[3], *highRow[3], *mixedRow[3], *sampledRow[3];
+        for (int c = 0; c < 3; ++c) {
+            lowRow[c] = &buffer[c*sourceWidth];
+            highRow[c] = &buffer[(3+c)*sourceWidth];
+            mixedRow[c] = &buffer[(6+c)*sourceWidth];
+            sampledRow[c] = &buffer[9*sourceWidth+c*width];
         }
+        int lowIndex = -1, highIndex = -1;
+        int end = min(output.height(), (band+1)*RENDER_BAND_ROWS);
+        for (int row = band*RENDER_BAND_ROWS; row < end; ++row) {
+            int l = y.low[row], h = y.high[row];
+            if (l != lowIndex) {
+                if (l == highIndex) {
+                    for (int c = 0; c < 3; ++c)
+                        std::swap(lowRow[c], highRow[c]);
+                    highIndex = -1;
+                } else
+                    source.readRow(lowRow, l);
+                lowIndex = l;
+            }
+            if (h != highIndex) {
+                source.readRow(highRow, h);
+                highIndex = h;
+            }
+            for (int c = 0; c < channels; ++c) {
+                mixValues(mixedRow[c], lowRow[c], highRow[c], y.weight[row], sourceWidth);
+                const float *mixed = mixedRow[c];
+                float *sampled = sampledRow[c];
+                for (int column = 0; column < width; ++column)
+                    sampled[column] = mix(mixed[x.low[column]], mixed[x.high[column]], x.weight[column]);
+            }
+            int outputChannels = channels;
+            if (channels == 3 && singleChannelOutput) {
+                medianValues(sampledRow[0], sampledRow[0], sampledRow[1], sampledRow[2], width);
+                outputChannels = 1;
+            }
+            for (int c = 0; c < outputChannels; ++c)
+                distanceValues(sampledRow[c], width, pxRange);
+            storeRow(output, row, sampledRow, outputChannels);
+        }
+    }
+
+private:
+    Output &output;
+    const Source &source;
+    bool singleChannelOutput;
+    float pxRange;
+    const SampleAxis &x, &y;
+
+};
+
+static void executeBands(ParallelTask &task, int rows, int rowsPerBand, Executor *executor) {
+    int bands = (rows+rowsPerBand-1)/rowsPerBand;
+    if (executor) {
+        executor->execute(task, bands);
+        return;
+    }
+#ifdef MSDFGEN_USE_OPENMP
+    #pragma omp parallel for
+#endif
+    for (int band = 0; band < bands; ++band)
+        task.run(band);
 }
 
-void renderSDF(Bitmap<FloatRGB> &output, const Bitmap<FloatRGB> &sdf, double pxRange) {
+template <class Output, class Source>
+static void renderSDFBands(Output &output, const Source &source, bool singleChannelOutput, double pxRange, Executor *executor) {
     int w = output.width(), h = output.height();
-    pxRange *= (double) (w+h)/(sdf.width()+sdf.height());
-    for (int y = 0; y < h; ++y)
-        for (int x = 0; x < w; ++x) {
-            FloatRGB s = sample(sdf, Point2((x+.5)/w, (y+.5)/h));
-            output(x, y).r = distVal(s.r, pxRange);
-            output(x, y).g = distVal(s.g, pxRange);
-            output(x, y).b = distVal(s.b, pxRange);
-        }
+    if (!w || !h || !source.width() || !source.height())
+        return;
+    pxRange *= (double) (w+h)/(source.width()+source.height());
+    SampleAxis x(w, source.width()), y(h, source.height());
+    RenderSDFTask<Output, Source> task(output, source, singleChannelOutput, float(pxRange), x, y);
+    executeBands(task, h, RENDER_BAND_ROWS, executor);
 }
 
-void simulate8bit(Bitmap<float> &bitmap) {
-    int w = bitmap.width(), h = bitmap.height();
-    for (int y = 0; y < h; ++y)
-        for (int x = 0; x < w; ++x) {
-            unsigned char v = clamp(int(bitmap(x, y)*0x100), 0xff);
-            bitmap(x, y) = v/255.f;
-        }
+void renderSDF(Bitmap<float> &output, const Bitmap<float> &sdf, double pxRange, Executor *executor) {
+    renderSDFBands(output, BitmapSource<float>(sdf), true, pxRange, executor);
 }
 
-void simulate8bit(Bitmap<FloatRGB> &bitmap) {
-    int w = bitmap.width(), h = bitmap.height();
-    for (int y = 0; y < h; ++y)
-        for (int x = 0; x < w; ++x) {
-            unsigned char r = clamp(int(bitmap(x, y).r*0x100), 0xff);
-            unsigned char g = clamp(int(bitmap(x, y).g*0x100), 0xff);
-            unsigned char b = clamp(int(bitmap(x, y).b*0x100), 0xff);
-            bitmap(x, y).r = r/255.f;
-            bitmap(x, y).g = g/255.f;
-            bitmap(x, y).b = b/255.f;
-        }
+void renderSDF(Bitmap<FloatRGB> &output, const Bitmap<float> &sdf, double pxRange, Executor *executor) {
+    renderSDFBands(output, BitmapSource<float>(sdf), false, pxRange, executor);
+}
+
+void renderSDF(Bitmap<float> &output, const Bitmap<FloatRGB> &sdf, double pxRange, Executor *executor) {
+    renderSDFBands(output, BitmapSource<FloatRGB>(sdf), true, pxRange, executor);
+}
+
+void renderSDF(Bitmap<FloatRGB> &output, const Bitmap<FloatRGB> &sdf, double pxRange, Executor *executor) {
+    renderSDFBands(output, BitmapSource<FloatRGB>(sdf), false, pxRange, executor);
+}
+
+void renderSDF(Bitmap<float> &output, const ByteBitmapConstRef &sdf, double pxRange, Executor *executor) {
+    renderSDFBands(output, ByteSource(sdf), true, pxRange, executor);
+}
+
+void renderSDF(Bitmap<FloatRGB> &output, const ByteBitmapConstRef &sdf, double pxRange, Executor *executor) {
+    renderSDFBands(output, ByteSource(sdf), false, pxRange, executor);
+}
+
+/// Quantizes a band of rows, whose pixels are consecutive floats.
+template <typename T>
+class Simulate8bitTask : public ParallelTask {
+
+public:
+    explicit Simulate8bitTask(Bitmap<T> &bitmap) : bitmap(bitmap) { }
+    void run(int band) {
+        int end = min(bitmap.height(), (band+1)*RENDER_BAND_ROWS);
+        for (int y = band*RENDER_BAND_ROWS; y < end; ++y)
+            quantizeValues(reinterpret_cast<float *>(&bitmap(0, y)), int(sizeof(T)/sizeof(float))*bitmap.width());
+    }
+
+private:
+    Bitmap<T> &bitmap;
+
+};
+
+void simulate8bit(Bitmap<float> &bitmap, Executor *executor) {
+    if (!bitmap.width())
+        return;
+    Simulate8bitTask<float> task(bitmap);
+    executeBands(task, bitmap.height(), RENDER_BAND_ROWS, executor);
+}
+
+void simulate8bit(Bitmap<FloatRGB> &bitmap, Executor *executor) {
+    if (!bitmap.width())
+        return;
+    Simulate8bitTask<FloatRGB> task(bitmap);
+    executeBands(task, bitmap.height(), RENDER_BAND_ROWS, executor);
 }
 
 }
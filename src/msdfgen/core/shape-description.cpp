@@ -1,41 +1,110 @@
 
 #include "msdfgen/core/shape-description.h"
 
+#include <cstring>
+
 namespace msdfgen {
 
 #ifdef _WIN32
     #pragma warning(disable:4996)
 #endif
 
-int readCharF(FILE *input) {
-    int c = '\0';
-    do {
-        c = fgetc(input);
-    } while (c == ' ' || c == '\t' || c == '\r' || c == '\n');
-    return c;
+/// The part of a text description that is left to read.
+struct DescriptionSpan {
+    const char *cur, *end;
+};
+
+static bool isSpace(int c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
 }
 
-int readCharS(const char **input) {
-    int c = '\0';
-    do {
-        c = *(*input)++;
-    } while (c == ' ' || c == '\t' || c == '\r' || c == '\n');
-    if (!c) {
-        --c;
-        return EOF;
+static int readChar(DescriptionSpan *input) {
+    while (input->cur < input->end) {
+        int c = (unsigned char) *input->cur++;
+        if (!(c == ' ' || c == '\t' || c == '\r' || c == '\n'))
+            return c;
     }
-    return c;
+    return EOF;
 }
 
-int readCoordF(FILE *input, Point2 &coord) {
-    return fscanf(input, "%lf,%lf", &coord.x, &coord.y);
+/// Reads a number the same way as the %lf conversion of scanf, and returns whether there was one.
+static bool readDouble(DescriptionSpan *input, double &value) {
+    const char *cur = input->cur, *end = input->end;
+    while (cur < end && isSpace(*cur))
+        ++cur;
+    // Plain decimal numbers whose digits and power of ten are both exact in double precision are
+    // converted directly, the result is correctly rounded just like strtod's.
+    const char *p = cur;
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-'))
+        negative = *p++ == '-';
+    unsigned long long mantissa = 0;
+    int digits = 0, significantDigits = 0, exponent = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p, ++digits) {
+        if (mantissa || *p != '0')
+            ++significantDigits;
+        mantissa = 10*mantissa+(*p-'0');
+    }
+    if (p < end && *p == '.') {
+        for (++p; p < end && *p >= '0' && *p <= '9'; ++p, ++digits) {
+            if (mantissa || *p != '0')
+                ++significantDigits;
+            mantissa = 10*mantissa+(*p-'0');
+            --exponent;
+        }
+    }
+    if (digits > 0 && significantDigits <= 15 && !(p < end && (((*p|0x20) >= 'a' && (*p|0x20) <= 'z') || *p == '.'))) {
+        static const double powersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+        if (exponent >= -22) {
+            value = exponent < 0 ? (double) mantissa/powersOf10[-exponent] : (double) mantissa;
+            if (negative)
+                value = -value;
+            input->cur = p;
+            return true;
+        }
+    }
+    // Anything else, such as exponents, hexadecimal numbers, infinities or long mantissas, is left to strtod
+    char buffer[128];
+    size_t length = 0;
+    for (p = cur; p < end && length < sizeof(buffer)-1; ++p, ++length) {
+        char c = *p;
+        if (!((c >= '0' && c <= '9') || ((c|0x20) >= 'a' && (c|0x20) <= 'z') || c == '.' || c == '+' || c == '-'))
+            break;
+        buffer[length] = c;
+    }
+    buffer[length] = '\0';
+    char *parsedEnd = buffer;
+    value = strtod(buffer, &parsedEnd);
+    if (parsedEnd == buffer)
+        return false;
+    // Like scanf, an exponent marker and sign without digits are consumed as part of the number
+    const char *bufferEnd = buffer+length;
+    bool hexadecimal = (parsedEnd-buffer > 2) && ((buffer[0] == '0' && (buffer[1]|0x20) == 'x') || (buffer[1] == '0' && (buffer[2]|0x20) == 'x'));
+    if (parsedEnd < bufferEnd && (*parsedEnd|0x20) == (hexadecimal ? 'p' : 'e')) {
+        ++parsedEnd;
+        if (parsedEnd < bufferEnd && (*parsedEnd == '+' || *parsedEnd == '-'))
+            ++parsedEnd;
+    }
+    input->cur = cur+(parsedEnd-buffer);
+    return true;
 }
 
-int readCoordS(const char **input, Point2 &coord) {
-    int read = 0;
-    int result = sscanf(*input, "%lf,%lf%n", &coord.x, &coord.y, &read);
-    *input += read;
-    return result;
+/// Reads a pair of coordinates the same way as scanf with the format "%lf,%lf", and returns the number that were read.
+/// Like scanf, nothing is consumed unless both are read, and EOF is returned if only whitespace is left.
+static int readCoord(DescriptionSpan *input, Point2 &coord) {
+    DescriptionSpan span = *input;
+    if (!readDouble(&span, coord.x)) {
+        while (span.cur < span.end && isSpace(*span.cur))
+            ++span.cur;
+        return span.cur == span.end ? EOF : 0;
+    }
+    if (span.cur == span.end || *span.cur != ',')
+        return 1;
+    ++span.cur;
+    if (!readDouble(&span, coord.y))
+        return 1;
+    *input = span;
+    return 2;
 }
 
 static bool writeCoord(FILE *output, Point2 coord) {
@@ -43,8 +112,7 @@ static bool writeCoord(FILE *output, Point2 coord) {
     return true;
 }
 
-template <typename T, int (*readChar)(T *), int (*readCoord)(T *, Point2 &)>
-static int readControlPoints(T *input, Point2 *output) {
+static int readControlPoints(DescriptionSpan *input, Point2 *output) {
     int result = readCoord(input, output[0]);
     if (result == 2) {
         switch (readChar(input)) {
@@ -63,8 +131,7 @@ static int readControlPoints(T *input, Point2 *output) {
     return -1;
 }
 
-template <typename T, int (*readChar)(T *), int (*readCoord)(T *, Point2 &)>
-static bool readContour(T *input, Contour &output, const Point2 *first, int terminator, bool &colorsSpecified) {
+static bool readContour(DescriptionSpan *input, Contour &output, const Point2 *first, int terminator, bool &colorsSpecified) {
     Point2 p[4], start;
     if (first)
         p[0] = *first;
@@ -122,7 +189,7 @@ static bool readContour(T *input, Contour &output, const Point2 *first, int term
                     goto FINISH_EDGE;
                 case '(':
                 READ_CONTROL_POINTS:
-                    if ((controlPoints = readControlPoints<T, readChar, readCoord>(input, p+1)) < 0)
+                    if ((controlPoints = readControlPoints(input, p+1)) < 0)
                         return false;
                     break;
                 default:
@@ -162,57 +229,43 @@ static bool readContour(T *input, Contour &output, const Point2 *first, int term
 }
 
 bool readShapeDescription(FILE *input, Shape &output, bool *colorsSpecified) {
-    bool locColorsSpec = false;
-    output.contours.clear();
-    output.inverseYAxis = false;
-    Point2 p;
-    int result = readCoordF(input, p);
-    if (result == 2) {
-        return readContour<FILE, readCharF, readCoordF>(input, output.addContour(), &p, EOF, locColorsSpec);
-    } else if (result == 1)
+    // The description is read to the end of the file anyway, so it's loaded at once and parsed in memory
+    std::vector<char> buffer;
+    char block[4096];
+    for (size_t length; (length = fread(block, 1, sizeof(block), input)) > 0;)
+        buffer.insert(buffer.end(), block, block+length);
+    if (ferror(input))
         return false;
-    else {
-        int c = readCharF(input);
-        if (c == '@') {
-            char after = '\0';
-            if (fscanf(input, "invert-y%c", &after) != 1)
-                return feof(input) != 0;
-            output.inverseYAxis = true;
-            c = after;
-            if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
-                c = readCharF(input);
-        }
-        for (; c == '{'; c = readCharF(input))
-            if (!readContour<FILE, readCharF, readCoordF>(input, output.addContour(), NULL, '}', locColorsSpec))
-                return false;
-        if (colorsSpecified)
-            *colorsSpecified = locColorsSpec;
-        return c == EOF && feof(input);
-    }
+    return readShapeDescription(buffer.empty() ? NULL : &buffer[0], buffer.size(), output, colorsSpecified);
 }
 
 bool readShapeDescription(const char *input, Shape &output, bool *colorsSpecified) {
+    return readShapeDescription(input, strlen(input), output, colorsSpecified);
+}
+
+bool readShapeDescription(const char *input, size_t length, Shape &output, bool *colorsSpecified) {
+    DescriptionSpan span = { input, input+length };
     bool locColorsSpec = false;
     output.contours.clear();
     output.inverseYAxis = false;
     Point2 p;
-    int result = readCoordS(&input, p);
+    int result = readCoord(&span, p);
     if (result == 2) {
-        return readContour<const char *, readCharS, readCoordS>(&input, output.addContour(), &p, EOF, locColorsSpec);
+        return readContour(&span, output.addContour(), &p, EOF, locColorsSpec);
     } else if (result == 1)
         return false;
     else {
-        int c = readCharS(&input);
+        int c = readChar(&span);
         if (c == '@') {
-            for (int i = 0; i < sizeof("invert-y")-1; ++i)
-                if (input[i] != "invert-y"[i])
-                    return false;
+            static const char invertY[] = "invert-y";
+            if ((size_t) (span.end-span.cur) < sizeof(invertY)-1 || memcmp(span.cur, invertY, sizeof(invertY)-1))
+                return false;
             output.inverseYAxis = true;
-            input += sizeof("invert-y")-1;
-            c = readCharS(&input);
+            span.cur += sizeof(invertY)-1;
+            c = readChar(&span);
         }
-        for (; c == '{'; c = readCharS(&input))
-            if (!readContour<const char *, readCharS, readCoordS>(&input, output.addContour(), NULL, '}', locColorsSpec))
+        for (; c == '{'; c = readChar(&span))
+            if (!readContour(&span, output.addContour(), NULL, '}', locColorsSpec))
                 return false;
         if (colorsSpecified)
             *colorsSpecified = locColorsSpec;
@@ -283,4 +336,137 @@ bool writeShapeDescription(FILE *output, const Shape &shape) {
     return true;
 }
 
+// Binary encoding: a header byte, the number of contours, and for each contour the number of edges followed by the edges.
+// An edge is a byte with its type and color, then the points after its start point, which is that of the previous edge's end
+// unless it's stored first. Counts are variable-length integers, coordinates are little-endian IEEE doubles.
+#define BINARY_INVERSE_Y_AXIS 0x01
+#define BINARY_EDGE_TYPE_MASK 0x03
+#define BINARY_EDGE_COLOR_SHIFT 2
+#define BINARY_EDGE_START_POINT 0x20
+
+static void writeBinaryCount(std::vector<unsigned char> &output, size_t count) {
+    while (count >= 0x80) {
+        output.push_back((unsigned char) (count|0x80));
+        count >>= 7;
+    }
+    output.push_back((unsigned char) count);
+}
+
+static void writeBinaryPoint(std::vector<unsigned char> &output, Point2 point) {
+    double coords[2] = { point.x, point.y };
+    for (int i = 0; i < 2; ++i) {
+        unsigned long long bits;
+        memcpy(&bits, coords+i, sizeof(bits));
+        for (int j = 0; j < 8; ++j, bits >>= 8)
+            output.push_back((unsigned char) bits);
+    }
+}
+
+/// Compares the bits of the coordinates, so that the start point is stored unless it's reproduced exactly, even for signed zeros.
+static bool isIdentical(Point2 a, Point2 b) {
+    return !memcmp(&a.x, &b.x, sizeof(a.x)) && !memcmp(&a.y, &b.y, sizeof(a.y));
+}
+
+static bool readBinaryCount(const unsigned char *&input, const unsigned char *end, size_t &count) {
+    count = 0;
+    for (int shift = 0; input < end && shift < 8*(int) sizeof(size_t); shift += 7) {
+        unsigned char byte = *input++;
+        count |= (size_t) (byte&0x7f)<<shift;
+        if (!(byte&0x80))
+            return true;
+    }
+    return false;
+}
+
+static bool readBinaryPoint(const unsigned char *&input, const unsigned char *end, Point2 &point) {
+    if (end-input < 16)
+        return false;
+    double coords[2];
+    for (int i = 0; i < 2; ++i) {
+        unsigned long long bits = 0;
+        for (int j = 7; j >= 0; --j)
+            bits = bits<<8|input[j];
+        memcpy(coords+i, &bits, sizeof(bits));
+        input += 8;
+    }
+    point = Point2(coords[0], coords[1]);
+    return true;
+}
+
+bool writeShapeBinary(std::vector<unsigned char> &output, const Shape &shape) {
+    size_t start = output.size();
+    output.push_back(shape.inverseYAxis ? BINARY_INVERSE_Y_AXIS : 0);
+    writeBinaryCount(output, shape.contours.size());
+    for (std::vector<Contour>::const_iterator contour = shape.contours.begin(); contour != shape.contours.end(); ++contour) {
+        writeBinaryCount(output, contour->edges.size());
+        Point2 end;
+        for (std::vector<EdgeHolder>::const_iterator edge = contour->edges.begin(); edge != contour->edges.end(); ++edge) {
+            const Point2 *p = NULL;
+            int type = 0;
+            if (const LinearSegment *e = dynamic_cast<const LinearSegment *>(&**edge))
+                p = e->p, type = 1;
+            else if (const QuadraticSegment *e = dynamic_cast<const QuadraticSegment *>(&**edge))
+                p = e->p, type = 2;
+            else if (const CubicSegment *e = dynamic_cast<const CubicSegment *>(&**edge))
+                p = e->p, type = 3;
+            else {
+                output.resize(start);
+                return false;
+            }
+            bool startPoint = edge == contour->edges.begin() || !isIdentical(p[0], end);
+            output.push_back((unsigned char) (type|(*edge)->color<<BINARY_EDGE_COLOR_SHIFT|(startPoint ? BINARY_EDGE_START_POINT : 0)));
+            for (int i = startPoint ? 0 : 1; i <= type; ++i)
+                writeBinaryPoint(output, p[i]);
+            end = p[type];
+        }
+    }
+    return true;
+}
+
+size_t readShapeBinary(const unsigned char *input, size_t length, Shape &output) {
+    const unsigned char *cur = input, *end = input+length;
+    output.contours.clear();
+    output.inverseYAxis = false;
+    if (cur == end || (*cur&~BINARY_INVERSE_Y_AXIS))
+        return 0;
+    output.inverseYAxis = (*cur++&BINARY_INVERSE_Y_AXIS) != 0;
+    size_t contourCount;
+    // Every contour takes at least a byte, which bounds the counts of malformed input
+    if (!readBinaryCount(cur, end, contourCount) || contourCount > (size_t) (end-cur))
+        return 0;
+    output.contours.reserve(contourCount);
+    for (size_t i = 0; i < contourCount; ++i) {
+        Contour &contour = output.addContour();
+        size_t edgeCount;
+        if (!readBinaryCount(cur, end, edgeCount) || edgeCount > (size_t) (end-cur))
+            return 0;
+        contour.edges.reserve(edgeCount);
+        Point2 p[4];
+        for (size_t j = 0; j < edgeCount; ++j) {
+            if (cur == end)
+                return 0;
+            int header = *cur++;
+            int type = header&BINARY_EDGE_TYPE_MASK;
+            EdgeColor color = EdgeColor(header>>BINARY_EDGE_COLOR_SHIFT&0x07);
+            if (!type || (header&~(BINARY_EDGE_TYPE_MASK|0x07<<BINARY_EDGE_COLOR_SHIFT|BINARY_EDGE_START_POINT)))
+                return 0;
+            if (header&BINARY_EDGE_START_POINT) {
+                if (!readBinaryPoint(cur, end, p[0]))
+                    return 0;
+            } else if (!j)
+                return 0;
+            for (int k = 1; k <= type; ++k)
+                if (!readBinaryPoint(cur, end, p[k]))
+                    return 0;
+            switch (type) {
+                case 1: contour.addEdge(EdgeHolder(p[0], p[1], color)); break;
+                case 2: contour.addEdge(EdgeHolder(p[0], p[1], p[2], color)); break;
+                case 3: contour.addEdge(EdgeHolder(p[0], p[1], p[2], p[3], color)); break;
+            }
+            p[0] = p[type];
+        }
+    }
+    return cur-input;
+}
+
 }
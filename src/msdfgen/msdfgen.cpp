@@ -1,59 +1,950 @@
 
 #include "msdfgen/msdfgen.h"
 
+#include <algorithm>
+
 #include "msdfgen/core/arithmetics.hpp"
 
+#define LARGE_VALUE 1e240
+
 namespace msdfgen {
 
-void generateSDF(Bitmap<float> &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate) {
-    int w = output.width(), h = output.height();
+class AdaptiveBlocks;
+
+/// The settings of a generator that apply to each of its rows.
+struct RowSettings {
+    bool warmStart;
+    /// If nonzero, pixels far from the outline are filled without computing their distance, see GeneratorConfig::bandLimited.
+    /// Its value is the sign of the distance of points outside the shape.
+    int outsideSign;
+    /// If set, the batches of pixels it contains are filled without computing their distance, see GeneratorConfig::adaptive.
+    const AdaptiveBlocks *blocks;
+};
+
+/// Returns the sign of the distance of points outside the shape, which depends on the orientation of its contours.
+template <typename P>
+static int outsideSign(const CompiledShapeT<P> &shape) {
+    if (shape.edges.empty())
+        return -1;
+    // Any point left of all edges is outside
+    double l = shape.edges[0].l;
+    for (typename std::vector<typename CompiledShapeT<P>::Edge>::const_iterator edge = shape.edges.begin(); edge != shape.edges.end(); ++edge)
+        l = min(l, double(edge->l));
+    Point2 outside(l-1, shape.edges[0].start.y);
+    SignedDistance minDistance;
+    for (typename std::vector<typename CompiledShapeT<P>::Edge>::const_iterator edge = shape.edges.begin(); edge != shape.edges.end(); ++edge) {
+        double param;
+        SignedDistance distance = edge->source->signedDistance(outside, param);
+        if (distance < minDistance)
+            minDistance = distance;
+    }
+    return minDistance.distance > 0 ? 1 : -1;
+}
+
+static int outsideSign(const Shape &shape) {
+    double l = LARGE_VALUE, b = LARGE_VALUE, r = -LARGE_VALUE, t = -LARGE_VALUE;
+    shape.bounds(l, b, r, t);
+    if (l > r)
+        return -1;
+    Point2 outside(l-1, b);
+    SignedDistance minDistance;
+    for (std::vector<Contour>::const_iterator contour = shape.contours.begin(); contour != shape.contours.end(); ++contour)
+        for (std::vector<EdgeHolder>::const_iterator edge = contour->edges.begin(); edge != contour->edges.end(); ++edge) {
+            double param;
+            SignedDistance distance = (*edge)->signedDistance(outside, param);
+            if (distance < minDistance)
+                minDistance = distance;
+        }
+    return minDistance.distance > 0 ? 1 : -1;
+}
+
+/// Runs a generator one output row at a time.
+template <class Output, typename P, void (*GENERATE_ROW)(Output &, const CompiledShapeT<P> &, const EdgeIndexT<P> &, double, const Vector2 &, const Vector2 &, const RowSettings &, int)>
+class GeneratorRowTask : public ParallelTask {
+
+public:
+    GeneratorRowTask(Output &output, const CompiledShapeT<P> &shape, const EdgeIndexT<P> &index, double range, const Vector2 &scale, const Vector2 &translate, const RowSettings &settings) :
+        output(output), shape(shape), index(index), range(range), scale(scale), translate(translate), settings(settings) { }
+    void run(int y) {
+        GENERATE_ROW(output, shape, index, range, scale, translate, settings, y);
+    }
+
+private:
+    Output &output;
+    const CompiledShapeT<P> &shape;
+    const EdgeIndexT<P> &index;
+    double range;
+    Vector2 scale, translate;
+    RowSettings settings;
+
+};
+
+static void executeRows(ParallelTask &task, int rows, Executor *executor) {
+    if (executor) {
+        executor->execute(task, rows);
+        return;
+    }
 #ifdef MSDFGEN_USE_OPENMP
     #pragma omp parallel for
 #endif
-    for (int y = 0; y < h; ++y) {
-        int row = shape.inverseYAxis ? h-y-1 : y;
-        for (int x = 0; x < w; ++x) {
-            double dummy;
-            Point2 p = Vector2(x+.5, y+.5)/scale-translate;
-            SignedDistance minDistance;
-            for (std::vector<Contour>::const_iterator contour = shape.contours.begin(); contour != shape.contours.end(); ++contour)
-                for (std::vector<EdgeHolder>::const_iterator edge = contour->edges.begin(); edge != contour->edges.end(); ++edge) {
-                    SignedDistance distance = (*edge)->signedDistance(p, dummy);
-                    if (distance < minDistance)
-                        minDistance = distance;
-                }
-            output(x, row) = float(minDistance.distance/range+.5);
-        }
-    }
+    for (int y = 0; y < rows; ++y)
+        task.run(y);
 }
 
-void generatePseudoSDF(Bitmap<float> &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate) {
-    int w = output.width(), h = output.height();
+/// Whether executeRows may process rows concurrently.
+static bool rowsRunConcurrently(Executor *executor) {
 #ifdef MSDFGEN_USE_OPENMP
-    #pragma omp parallel for
+    return true;
+#else
+    return executor != NULL;
 #endif
-    for (int y = 0; y < h; ++y) {
-        int row = shape.inverseYAxis ? h-y-1 : y;
-        for (int x = 0; x < w; ++x) {
-            Point2 p = Vector2(x+.5, y+.5)/scale-translate;
-            SignedDistance minDistance;
-            const EdgeHolder *nearEdge = NULL;
-            double nearParam = 0;
-            for (std::vector<Contour>::const_iterator contour = shape.contours.begin(); contour != shape.contours.end(); ++contour)
-                for (std::vector<EdgeHolder>::const_iterator edge = contour->edges.begin(); edge != contour->edges.end(); ++edge) {
+}
+
+/// Blocks of pixels that are entirely farther than range/2 from the outline, see GeneratorConfig::adaptive.
+/// They are found by subdividing the output as a quadtree. The distance is evaluated at the center of each block, and if it exceeds range/2
+/// by more than the distance to the farthest pixel of the block, so does the distance of every pixel, since it is 1-Lipschitz.
+/// Otherwise, the block is split in four, down to the size of a batch of pixels.
+class AdaptiveBlocks {
+
+public:
+    /// The width and height of the largest blocks in pixels.
+    static const int ROOT_SIZE = 64;
+
+    /// Finds the blocks if config.adaptive is set, otherwise the result is empty.
+    template <typename P>
+    AdaptiveBlocks(const CompiledShapeT<P> &shape, int width, int height, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config);
+    bool empty() const {
+        return values.empty();
+    }
+    /// Retrieves the value of the batch of pixels that starts at (x, y), 0 outside and 1 inside the shape.
+    /// Returns false if the batch is not contained in a block.
+    bool lookup(int x, int y, float &value) const {
+        signed char batchValue = values[y*columns+x/batchSize];
+        value = float(batchValue);
+        return batchValue >= 0;
+    }
+    /// Marks the pixels from (x0, y0) to (x1, y1) exclusive as inside or outside the shape. x0 must be the start of a batch.
+    void fill(int x0, int y0, int x1, int y1, bool inside) {
+        for (int y = y0; y < y1; ++y)
+            for (int column = x0/batchSize; column*batchSize < x1; ++column)
+                values[y*columns+column] = inside ? 1 : 0;
+    }
+
+private:
+    /// One value per batch of each row, -1 for batches that have to be generated.
+    std::vector<signed char> values;
+    int columns;
+    int batchSize;
+
+};
+
+/// Classifies one row of the largest blocks of AdaptiveBlocks.
+template <typename P>
+class AdaptiveBlockTask : public ParallelTask {
+
+public:
+    AdaptiveBlockTask(AdaptiveBlocks &blocks, const CompiledShapeT<P> &shape, int width, int height, double range, const Vector2 &scale, const Vector2 &translate) :
+        blocks(blocks), shape(shape), width(width), height(height), halfRange(.5*range), scale(scale), translate(translate), edgeBounds(4*shape.edges.size()) {
+        for (int i = 0; i < (int) shape.edges.size(); ++i) {
+            double *bounds = &edgeBounds[4*i];
+            bounds[0] = bounds[1] = LARGE_VALUE, bounds[2] = bounds[3] = -LARGE_VALUE;
+            shape.edges[i].source->bounds(bounds[0], bounds[1], bounds[2], bounds[3]);
+        }
+    }
+    void run(int row) {
+        for (int x = 0; x < width; x += AdaptiveBlocks::ROOT_SIZE)
+            classify(x, row*AdaptiveBlocks::ROOT_SIZE, AdaptiveBlocks::ROOT_SIZE, 0);
+    }
+
+private:
+    AdaptiveBlocks &blocks;
+    const CompiledShapeT<P> &shape;
+    int width, height;
+    double halfRange;
+    Vector2 scale, translate;
+    /// The bounding box of each edge.
+    std::vector<double> edgeBounds;
+
+    void classify(int x0, int y0, int size, int nearEdge) {
+        int x1 = min(x0+size, width), y1 = min(y0+size, height);
+        Point2 center = Vector2(.5*(x0+x1), .5*(y0+y1))/scale-translate;
+        // The distance between the center and the farthest pixel of the block
+        double radius = .5*Vector2((x1-x0-1)/fabs(scale.x), (y1-y0-1)/fabs(scale.y)).length();
+        double distance = signedDistance(center, nearEdge);
+        // A small margin absorbs rounding errors
+        if (fabs(distance)-radius > halfRange*(1+1e-6)) {
+            blocks.fill(x0, y0, x1, y1, distance > 0);
+            return;
+        }
+        if (size <= CompiledShapeT<P>::BATCH_SIZE)
+            return;
+        int half = size/2;
+        for (int y = y0; y < y1; y += half)
+            for (int x = x0; x < x1; x += half)
+                classify(x, y, half, nearEdge);
+    }
+
+    /// Returns the signed distance between p and the outline. The edge nearEdge is evaluated first, and is replaced by the nearest edge.
+    double signedDistance(Point2 p, int &nearEdge) const {
+        SignedDistance minDistance;
+        int nearest = -1;
+        for (int k = -1; k < (int) shape.edges.size(); ++k) {
+            int i = k < 0 ? nearEdge : k;
+            if (k == nearEdge || i >= (int) shape.edges.size())
+                continue;
+            const double *bounds = &edgeBounds[4*i];
+            double dx = max(max(bounds[0]-p.x, p.x-bounds[2]), 0.);
+            double dy = max(max(bounds[1]-p.y, p.y-bounds[3]), 0.);
+            // Edges at the same distance are evaluated too, since the sign of a tie at a corner depends on both of them
+            double maxDistance = fabs(minDistance.distance)*(1+1e-9);
+            if (dx*dx+dy*dy > maxDistance*maxDistance)
+                continue;
+            double param;
+            SignedDistance distance = shape.edges[i].source->signedDistance(p, param);
+            if (distance < minDistance) {
+                minDistance = distance;
+                nearest = i;
+            }
+        }
+        if (nearest >= 0)
+            nearEdge = nearest;
+        return minDistance.distance;
+    }
+
+};
+
+template <typename P>
+AdaptiveBlocks::AdaptiveBlocks(const CompiledShapeT<P> &shape, int width, int height, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config) :
+    columns(0), batchSize(CompiledShapeT<P>::BATCH_SIZE) {
+    if (!config.adaptive || width <= 0 || height <= 0)
+        return;
+    columns = (width+batchSize-1)/batchSize;
+    values.resize(columns*height, -1);
+    if (shape.edges.empty())
+        return;
+    AdaptiveBlockTask<P> task(*this, shape, width, height, range, scale, translate);
+    executeRows(task, (height+ROOT_SIZE-1)/ROOT_SIZE, config.executor);
+}
+
+template <typename P>
+static RowSettings rowSettings(const CompiledShapeT<P> &shape, const GeneratorConfig &config, const AdaptiveBlocks &blocks) {
+    RowSettings settings;
+    settings.warmStart = config.warmStart;
+    settings.outsideSign = config.bandLimited ? outsideSign(shape) : 0;
+    settings.blocks = blocks.empty() ? NULL : &blocks;
+    return settings;
+}
+
+/// Stores the generated rows in a bitmap, in reverse order if the shape's Y axis is inverted.
+template <typename T>
+class BitmapOutput {
+
+public:
+    BitmapOutput(Bitmap<T> &bitmap, bool inverseYAxis) : bitmap(bitmap), inverseYAxis(inverseYAxis) { }
+    int width() const {
+        return bitmap.width();
+    }
+    void set(int x, int y, float value) {
+        bitmap(x, row(y)) = value;
+    }
+    void set(int x, int y, float r, float g, float b) {
+        bitmap(x, row(y)) = FloatRGB(r, g, b);
+    }
+
+private:
+    Bitmap<T> &bitmap;
+    bool inverseYAxis;
+
+    int row(int y) const {
+        return inverseYAxis ? bitmap.height()-y-1 : y;
+    }
+
+};
+
+/// Quantizes the generated rows to 8 bits and stores them in the caller's memory, see ByteBitmapRef.
+class ByteOutput {
+
+public:
+    ByteOutput(const ByteBitmapRef &target, bool inverseYAxis) : target(target), inverseYAxis(inverseYAxis) { }
+    int width() const {
+        return target.width;
+    }
+    void set(int x, int y, float value) {
+        *pixel(x, y) = quantize(value);
+    }
+    void set(int x, int y, float r, float g, float b) {
+        unsigned char *p = pixel(x, y);
+        p[0] = quantize(r);
+        p[1] = quantize(g);
+        p[2] = quantize(b);
+    }
+
+private:
+    ByteBitmapRef target;
+    bool inverseYAxis;
+
+    unsigned char * pixel(int x, int y) const {
+        int row = inverseYAxis ? target.height-y-1 : y;
+        return target.pixels+row*target.rowStride+x*target.pixelStride;
+    }
+    unsigned char quantize(float value) const {
+        if (target.invert)
+            value = 1.f-value;
+        return (unsigned char) (clamp(value)*255.f);
+    }
+
+};
+
+/// Keeps the last three generated rows of a multi-channel distance field, which is all error correction needs to finish a row.
+class RowWindow {
+
+public:
+    RowWindow(int width, int height) : rows(width, 3), h(height) { }
+    int width() const {
+        return rows.width();
+    }
+    void set(int x, int y, float r, float g, float b) {
+        rows(x, y%3) = FloatRGB(r, g, b);
+    }
+    /// Returns row y, or NULL if it is outside the bitmap.
+    const FloatRGB * row(int y) const {
+        return y >= 0 && y < h ? &rows(0, y%3) : NULL;
+    }
+
+private:
+    Bitmap<FloatRGB> rows;
+    int h;
+
+};
+
+/// The shape space coordinates of up to a batch of horizontally adjacent pixels, starting at (x, y).
+/// The coordinates are computed in double precision and rounded to P.
+template <typename P>
+struct PixelBatch {
+    P x[CompiledShapeT<P>::BATCH_SIZE], y[CompiledShapeT<P>::BATCH_SIZE];
+    int count;
+
+    PixelBatch(int x0, int y0, int width, const Vector2 &scale, const Vector2 &translate) : count(min(CompiledShapeT<P>::BATCH_SIZE, width-x0)) {
+        for (int i = 0; i < CompiledShapeT<P>::BATCH_SIZE; ++i) {
+            Point2 p = Vector2(x0+i+.5, y0+.5)/scale-translate;
+            x[i] = P(p.x), y[i] = P(p.y);
+        }
+    }
+    Vector2T<P> point(int i) const {
+        return Vector2T<P>(x[i], y[i]);
+    }
+};
+
+/// The nearest edge found so far for a pixel.
+template <typename P>
+struct EdgePoint {
+    typedef typename CompiledShapeT<P>::Edge Edge;
+
+    SignedDistanceT<P> minDistance;
+    const Edge *nearEdge;
+    P nearParam;
+
+    EdgePoint() : nearEdge(NULL), nearParam(0) { }
+    void update(const SignedDistanceT<P> &distance, const Edge *edge, P param) {
+        if (distance < minDistance) {
+            minDistance = distance;
+            nearEdge = edge;
+            nearParam = param;
+        }
+    }
+    void applyPseudoDistance(Vector2T<P> p) {
+        if (nearEdge)
+            CompiledShapeT<P>::distanceToPseudoDistance(*nearEdge, minDistance, p, nearParam);
+    }
+};
+
+/// The nearest edges of the previous batch of pixels in the row, which are likely to be the nearest edges of the next batch as well.
+/// They are evaluated before the other edges, so that their distances bound the search from the start.
+/// Their results are kept and used when the edges are reached in the original order, which makes the result identical.
+template <typename P>
+class SeedEdges {
+
+public:
+    typedef typename CompiledShapeT<P>::Edge Edge;
+
+    SeedEdges() : count(0) { }
+    void clear() {
+        count = 0;
+    }
+    void add(const Edge *edge) {
+        if (edge && count < MAX_SEEDS && find(edge) < 0)
+            edges[count++] = edge;
+    }
+    void evaluate(const CompiledShapeT<P> &shape, const PixelBatch<P> &batch) {
+        for (int s = 0; s < count; ++s)
+            shape.signedDistanceBatch(*edges[s], batch.x, batch.y, distance[s], param[s]);
+    }
+    /// Returns an upper bound of the distance between pixel i of the batch and its nearest edge of the specified color.
+    P bound(int i, int color) const {
+        P result = P(fabs(SignedDistanceT<P>::INFINITE.distance));
+        for (int s = 0; s < count; ++s)
+            if (edges[s]->color&color)
+                result = min(result, P(fabs(distance[s][i].distance)));
+        return result;
+    }
+    /// Retrieves the already computed distances of the edge from the batch, if it is one of the seeds.
+    bool lookup(const Edge *edge, const SignedDistanceT<P> *&edgeDistance, const P *&edgeParam) const {
+        int s = find(edge);
+        if (s < 0)
+            return false;
+        edgeDistance = distance[s];
+        edgeParam = param[s];
+        return true;
+    }
+
+private:
+    static const int MAX_SEEDS = 3;
+
+    const Edge *edges[MAX_SEEDS];
+    SignedDistanceT<P> distance[MAX_SEEDS][CompiledShapeT<P>::BATCH_SIZE];
+    P param[MAX_SEEDS][CompiledShapeT<P>::BATCH_SIZE];
+    int count;
+
+    int find(const Edge *edge) const {
+        for (int s = 0; s < count; ++s)
+            if (edges[s] == edge)
+                return s;
+        return -1;
+    }
+
+};
+
+/// Finds the pixels of a row that are at least range/2 from the outline, see GeneratorConfig::bandLimited and GeneratorConfig::adaptive.
+/// Such pixels lie either in one of the AdaptiveBlocks, in a tile that is that far from every edge, or near a pixel whose distance exceeds
+/// range/2 by more than their distance from it, since the distance to the outline changes no faster than the position.
+/// Pixels in such tiles are classified by the row's scanline.
+template <typename P>
+class OutsideBand {
+
+public:
+    OutsideBand(const CompiledShapeT<P> &shape, const EdgeIndexT<P> &index, double range, const Vector2 &scale, const Vector2 &translate, const RowSettings &settings, int y) :
+        shape(shape), index(index), halfRange(.5*range), scale(scale), translate(translate), outsideSign(settings.outsideSign), blocks(settings.blocks), y(y),
+        scanlineReady(false), knownEnd(0), knownValue(0) { }
+    /// Returns true if all count pixels from x are outside the band, and stores their values, 0 outside and 1 inside the shape.
+    bool contains(int x, int count, float *values) {
+        float blockValue;
+        if (blocks && blocks->lookup(x, y, blockValue)) {
+            for (int i = 0; i < count; ++i)
+                values[i] = blockValue;
+            return true;
+        }
+        if (!outsideSign)
+            return false;
+        if (x+count <= knownEnd) {
+            for (int i = 0; i < count; ++i)
+                values[i] = knownValue;
+            return true;
+        }
+        if (index.tileDistance(x, y) <= halfRange)
+            return false;
+        if (!scanlineReady) {
+            shape.scanline(scanline, (y+.5)/scale.y-translate.y);
+            scanlineReady = true;
+        }
+        for (int i = 0; i < count; ++i)
+            values[i] = scanline.filled((x+i+.5)/scale.x-translate.x) == (outsideSign < 0) ? 1.f : 0.f;
+        return true;
+    }
+    /// Records the signed distance between pixel x and the outline.
+    void setDistance(int x, P distance) {
+        if (!outsideSign)
+            return;
+        // The number of following pixels that are nearer to pixel x than its distance from the band, a small margin absorbs rounding errors
+        double reach = (fabs(distance)-halfRange*(1+1e-6))*fabs(scale.x);
+        if (reach >= 1) {
+            knownEnd = x+1+int(reach);
+            knownValue = distance > 0 ? 1.f : 0.f;
+        }
+    }
+
+private:
+    const CompiledShapeT<P> &shape;
+    const EdgeIndexT<P> &index;
+    double halfRange;
+    Vector2 scale, translate;
+    int outsideSign;
+    const AdaptiveBlocks *blocks;
+    int y;
+    Scanline scanline;
+    bool scanlineReady;
+    /// The pixels before knownEnd are outside the band, with the value knownValue, unless they are before the last pixel set by setDistance.
+    int knownEnd;
+    float knownValue;
+
+};
+
+/// Computes the distances of an edge from a batch of pixels, unless they have already been computed for the seeds.
+template <typename P>
+static inline void edgeDistances(const CompiledShapeT<P> &shape, const SeedEdges<P> &seeds, const typename CompiledShapeT<P>::Edge *edge, const PixelBatch<P> &batch,
+    SignedDistanceT<P> *distanceBuffer, P *paramBuffer, const SignedDistanceT<P> *&distance, const P *&param) {
+    if (seeds.lookup(edge, distance, param))
+        return;
+    shape.signedDistanceBatch(*edge, batch.x, batch.y, distanceBuffer, paramBuffer);
+    distance = distanceBuffer;
+    param = paramBuffer;
+}
+
+template <class Output, typename P>
+static void generateSDFRow(Output &output, const CompiledShapeT<P> &shape, const EdgeIndexT<P> &index, double range, const Vector2 &scale, const Vector2 &translate, const RowSettings &settings, int y) {
+    int w = output.width();
+    SeedEdges<P> seeds;
+    OutsideBand<P> band(shape, index, range, scale, translate, settings, y);
+    for (int x = 0; x < w; x += CompiledShapeT<P>::BATCH_SIZE) {
+        PixelBatch<P> batch(x, y, w, scale, translate);
+        float values[CompiledShapeT<P>::BATCH_SIZE];
+        if (band.contains(x, batch.count, values)) {
+            for (int i = 0; i < batch.count; ++i)
+                output.set(x+i, y, values[i]);
+            continue;
+        }
+        const typename EdgeIndexT<P>::Entry * const *begin, * const *end;
+        index.tileEntries(x, y, begin, end);
+        EdgePoint<P> near[CompiledShapeT<P>::BATCH_SIZE];
+        P bound[CompiledShapeT<P>::BATCH_SIZE];
+        seeds.evaluate(shape, batch);
+        for (int i = 0; i < batch.count; ++i)
+            bound[i] = seeds.bound(i, WHITE);
+        for (const typename EdgeIndexT<P>::Entry * const *entry = begin; entry != end; ++entry) {
+            bool skip = true;
+            for (int i = 0; i < batch.count && skip; ++i)
+                skip = index.isFartherThan(**entry, batch.point(i), min(P(fabs(near[i].minDistance.distance)), bound[i]));
+            if (skip)
+                continue;
+            const typename CompiledShapeT<P>::Edge *edge = *entry;
+            SignedDistanceT<P> distanceBuffer[CompiledShapeT<P>::BATCH_SIZE];
+            P paramBuffer[CompiledShapeT<P>::BATCH_SIZE];
+            const SignedDistanceT<P> *distance;
+            const P *param;
+            edgeDistances(shape, seeds, edge, batch, distanceBuffer, paramBuffer, distance, param);
+            for (int i = 0; i < batch.count; ++i)
+                near[i].update(distance[i], edge, param[i]);
+        }
+        seeds.clear();
+        if (settings.warmStart)
+            seeds.add(near[batch.count-1].nearEdge);
+        band.setDistance(x+batch.count-1, near[batch.count-1].minDistance.distance);
+        for (int i = 0; i < batch.count; ++i)
+            output.set(x+i, y, float(near[i].minDistance.distance/range+.5));
+    }
+}
+
+void generateSDF(Bitmap<float> &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config) {
+    generateSDF(output, CompiledShape(shape), range, scale, translate, config);
+}
+
+template <typename P>
+void generateSDF(Bitmap<float> &output, const CompiledShapeT<P> &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config) {
+    EdgeIndexT<P> index(shape, output.width(), output.height(), scale, translate, false);
+    AdaptiveBlocks blocks(shape, output.width(), output.height(), range, scale, translate, config);
+    BitmapOutput<float> target(output, shape.inverseYAxis);
+    GeneratorRowTask<BitmapOutput<float>, P, generateSDFRow<BitmapOutput<float>, P> > task(target, shape, index, range, scale, translate, rowSettings(shape, config, blocks));
+    executeRows(task, output.height(), config.executor);
+}
+
+void generateSDF(const ByteBitmapRef &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config) {
+    generateSDF(output, CompiledShape(shape), range, scale, translate, config);
+}
+
+template <typename P>
+void generateSDF(const ByteBitmapRef &output, const CompiledShapeT<P> &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config) {
+    EdgeIndexT<P> index(shape, output.width, output.height, scale, translate, false);
+    AdaptiveBlocks blocks(shape, output.width, output.height, range, scale, translate, config);
+    ByteOutput target(output, shape.inverseYAxis);
+    GeneratorRowTask<ByteOutput, P, generateSDFRow<ByteOutput, P> > task(target, shape, index, range, scale, translate, rowSettings(shape, config, blocks));
+    executeRows(task, output.height, config.executor);
+}
+
+template <class Output, typename P>
+static void generatePseudoSDFRow(Output &output, const CompiledShapeT<P> &shape, const EdgeIndexT<P> &index, double range, const Vector2 &scale, const Vector2 &translate, const RowSettings &settings, int y) {
+    int w = output.width();
+    SeedEdges<P> seeds;
+    OutsideBand<P> band(shape, index, range, scale, translate, settings, y);
+    for (int x = 0; x < w; x += CompiledShapeT<P>::BATCH_SIZE) {
+        PixelBatch<P> batch(x, y, w, scale, translate);
+        float values[CompiledShapeT<P>::BATCH_SIZE];
+        if (band.contains(x, batch.count, values)) {
+            for (int i = 0; i < batch.count; ++i)
+                output.set(x+i, y, values[i]);
+            continue;
+        }
+        const typename EdgeIndexT<P>::Entry * const *begin, * const *end;
+        index.tileEntries(x, y, begin, end);
+        EdgePoint<P> near[CompiledShapeT<P>::BATCH_SIZE];
+        P bound[CompiledShapeT<P>::BATCH_SIZE];
+        seeds.evaluate(shape, batch);
+        for (int i = 0; i < batch.count; ++i)
+            bound[i] = seeds.bound(i, WHITE);
+        for (const typename EdgeIndexT<P>::Entry * const *entry = begin; entry != end; ++entry) {
+            bool skip = true;
+            for (int i = 0; i < batch.count && skip; ++i)
+                skip = index.isFartherThan(**entry, batch.point(i), min(P(fabs(near[i].minDistance.distance)), bound[i]));
+            if (skip)
+                continue;
+            const typename CompiledShapeT<P>::Edge *edge = *entry;
+            SignedDistanceT<P> distanceBuffer[CompiledShapeT<P>::BATCH_SIZE];
+            P paramBuffer[CompiledShapeT<P>::BATCH_SIZE];
+            const SignedDistanceT<P> *distance;
+            const P *param;
+            edgeDistances(shape, seeds, edge, batch, distanceBuffer, paramBuffer, distance, param);
+            for (int i = 0; i < batch.count; ++i)
+                near[i].update(distance[i], edge, param[i]);
+        }
+        seeds.clear();
+        if (settings.warmStart)
+            seeds.add(near[batch.count-1].nearEdge);
+        band.setDistance(x+batch.count-1, near[batch.count-1].minDistance.distance);
+        for (int i = 0; i < batch.count; ++i) {
+            near[i].applyPseudoDistance(batch.point(i));
+            output.set(x+i, y, float(near[i].minDistance.distance/range+.5));
+        }
+    }
+}
+
+void generatePseudoSDF(Bitmap<float> &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config) {
+    generatePseudoSDF(output, CompiledShape(shape), range, scale, translate, config);
+}
+
+template <typename P>
+void generatePseudoSDF(Bitmap<float> &output, const CompiledShapeT<P> &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config) {
+    EdgeIndexT<P> index(shape, output.width(), output.height(), scale, translate, false);
+    AdaptiveBlocks blocks(shape, output.width(), output.height(), range, scale, translate, config);
+    BitmapOutput<float> target(output, shape.inverseYAxis);
+    GeneratorRowTask<BitmapOutput<float>, P, generatePseudoSDFRow<BitmapOutput<float>, P> > task(target, shape, index, range, scale, translate, rowSettings(shape, config, blocks));
+    executeRows(task, output.height(), config.executor);
+}
+
+void generatePseudoSDF(const ByteBitmapRef &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config) {
+    generatePseudoSDF(output, CompiledShape(shape), range, scale, translate, config);
+}
+
+template <typename P>
+void generatePseudoSDF(const ByteBitmapRef &output, const CompiledShapeT<P> &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config) {
+    EdgeIndexT<P> index(shape, output.width, output.height, scale, translate, false);
+    AdaptiveBlocks blocks(shape, output.width, output.height, range, scale, translate, config);
+    ByteOutput target(output, shape.inverseYAxis);
+    GeneratorRowTask<ByteOutput, P, generatePseudoSDFRow<ByteOutput, P> > task(target, shape, index, range, scale, translate, rowSettings(shape, config, blocks));
+    executeRows(task, output.height, config.executor);
+}
+
+/// An axis of the output of the distance transform. Positions along it are measured in shape units from the first pixel's edge,
+/// so that they increase with the pixel coordinate and distances are preserved whatever the sign of the scale.
+struct TransformAxis {
+    int pixels;
+    double scale, translate;
+
+    TransformAxis(int pixels, double scale, double translate) : pixels(pixels), scale(scale), translate(translate) { }
+    /// Converts a pixel coordinate to shape space.
+    double shapeCoordinate(double pixel) const {
+        return pixel/scale-translate;
+    }
+    /// Returns the position of a pixel coordinate.
+    double position(double pixel) const {
+        return pixel/fabs(scale);
+    }
+    /// Returns the position of a shape space coordinate.
+    double shapePosition(double coordinate) const {
+        return (coordinate+translate)*scale/fabs(scale);
+    }
+};
+
+/// The nearest sample of the outline found for a pixel by the distance transform.
+struct OutlineSample {
+    double squaredDistance;
+    /// The index of the edge the sample lies on, or -1 if none has been found.
+    int edge;
+
+    OutlineSample() : squaredDistance(LARGE_VALUE), edge(-1) { }
+    OutlineSample(double squaredDistance, int edge) : squaredDistance(squaredDistance), edge(edge) { }
+};
+
+/// Finds the nearest of the points where the outline crosses a set of evenly spaced parallel lines for each output pixel.
+/// The lines are horizontal in the space of the given edges, which may contain NULL for edges to skip, i.e. they run along the axis u and are spaced along the axis v,
+/// supersampling lines per pixel, with one through the center of each row of pixels. They continue past the output by margin pixels,
+/// so that points outside are sampled too. The result of pixel (i, j), where i is along u and j along v, is stored at index j*u.pixels+i.
+/// The distances along each line are found first, then they are combined across the lines by a separable distance transform,
+/// see Felzenszwalb & Huttenlocher, Distance Transforms of Sampled Functions.
+class CrossingDistanceTransform {
+
+public:
+    /// If fill is set, the transform also records which pixels are inside the shape by the nonzero rule, see filled.
+    CrossingDistanceTransform(const std::vector<const EdgeSegment *> &edges, const TransformAxis &u, const TransformAxis &v, int supersampling, int margin, bool fill) :
+        edges(edges), u(u), v(v), supersampling(supersampling), margin(margin), lineCount((v.pixels+2*margin)*supersampling),
+        lineOffset(supersampling%2 ? .5 : 0.), fill(fill) {
+        // Lists the edges that may cross each line
+        std::vector<int> first(edges.size(), 0), last(edges.size(), -1);
+        lineOffsets.assign(lineCount+1, 0);
+        for (int e = 0; e < (int) edges.size(); ++e) {
+            if (!edges[e])
+                continue;
+            double l = LARGE_VALUE, b = LARGE_VALUE, r = -LARGE_VALUE, t = -LARGE_VALUE;
+            edges[e]->bounds(l, b, r, t);
+            double lo = (b+v.translate)*v.scale, hi = (t+v.translate)*v.scale;
+            if (lo > hi)
+                std::swap(lo, hi);
+            first[e] = max((int) floor((lo+margin)*supersampling-lineOffset), 0);
+            last[e] = min((int) ceil((hi+margin)*supersampling-lineOffset), lineCount-1);
+            for (int line = first[e]; line <= last[e]; ++line)
+                ++lineOffsets[line+1];
+        }
+        for (int line = 0; line < lineCount; ++line)
+            lineOffsets[line+1] += lineOffsets[line];
+        lineEdges.resize(lineOffsets[lineCount]);
+        std::vector<int> next(lineOffsets.begin(), lineOffsets.end()-1);
+        for (int e = 0; e < (int) edges.size(); ++e)
+            for (int line = first[e]; line <= last[e]; ++line)
+                lineEdges[next[line]++] = e;
+    }
+    /// Computes the result, which has u.pixels*v.pixels elements.
+    void compute(std::vector<OutlineSample> &result, Executor *executor) {
+        lineSamples.resize(lineCount*u.pixels);
+        if (fill)
+            filledPixels.resize(u.pixels*v.pixels);
+        LineTask lineTask(*this);
+        executeRows(lineTask, lineCount, executor);
+        result.resize(u.pixels*v.pixels);
+        EnvelopeTask envelopeTask(*this, result);
+        executeRows(envelopeTask, u.pixels, executor);
+    }
+    /// Returns true if pixel (i, j) is inside the shape.
+    bool filled(int i, int j) const {
+        return filledPixels[j*u.pixels+i] != 0;
+    }
+
+private:
+    /// A point where a line crosses the outline.
+    struct Crossing {
+        double position;
+        int edge;
+        int direction;
+
+        bool operator<(const Crossing &other) const {
+            return position < other.position;
+        }
+    };
+
+    /// Finds the nearest crossings along one line.
+    class LineTask : public ParallelTask {
+    public:
+        explicit LineTask(CrossingDistanceTransform &transform) : transform(transform) { }
+        void run(int line) {
+            transform.computeLine(line);
+        }
+    private:
+        CrossingDistanceTransform &transform;
+    };
+
+    /// Combines the lines' nearest crossings for one column of pixels across the lines.
+    class EnvelopeTask : public ParallelTask {
+    public:
+        EnvelopeTask(CrossingDistanceTransform &transform, std::vector<OutlineSample> &result) : transform(transform), result(result) { }
+        void run(int i) {
+            transform.computeColumn(result, i);
+        }
+    private:
+        CrossingDistanceTransform &transform;
+        std::vector<OutlineSample> &result;
+    };
+
+    const std::vector<const EdgeSegment *> &edges;
+    TransformAxis u, v;
+    int supersampling, margin;
+    int lineCount;
+    double lineOffset;
+    bool fill;
+    std::vector<int> lineOffsets;
+    std::vector<int> lineEdges;
+    /// The nearest crossing of each line to each pixel column, lineCount rows of u.pixels.
+    std::vector<OutlineSample> lineSamples;
+    std::vector<unsigned char> filledPixels;
+
+    /// Returns the pixel coordinate of the line along v.
+    double linePixel(int line) const {
+        return (line+lineOffset)/supersampling-margin;
+    }
+
+    void computeLine(int line) {
+        std::vector<Crossing> crossings;
+        double y = v.shapeCoordinate(linePixel(line));
+        for (int k = lineOffsets[line]; k < lineOffsets[line+1]; ++k) {
+            double x[3];
+            int dy[3];
+            int n = edges[lineEdges[k]]->scanlineIntersections(x, dy, y);
+            for (int i = 0; i < n; ++i) {
+                Crossing crossing = { u.shapePosition(x[i]), lineEdges[k], dy[i] };
+                crossings.push_back(crossing);
+            }
+        }
+        std::sort(crossings.begin(), crossings.end());
+        // The row of pixels whose centers lie on the line, if any
+        int row = -1;
+        if (fill && (line-supersampling/2)%supersampling == 0)
+            row = (line-supersampling/2)/supersampling-margin;
+        if (row < 0 || row >= v.pixels)
+            row = -1;
+        OutlineSample *samples = &lineSamples[line];
+        int next = 0, winding = 0;
+        for (int i = 0; i < u.pixels; ++i) {
+            double p = u.position(i+.5);
+            while (next < (int) crossings.size() && crossings[next].position < p)
+                winding += crossings[next++].direction;
+            OutlineSample sample;
+            if (next < (int) crossings.size())
+                sample = OutlineSample((crossings[next].position-p)*(crossings[next].position-p), crossings[next].edge);
+            if (next > 0 && (p-crossings[next-1].position)*(p-crossings[next-1].position) < sample.squaredDistance)
+                sample = OutlineSample((p-crossings[next-1].position)*(p-crossings[next-1].position), crossings[next-1].edge);
+            samples[i*lineCount] = sample;
+            if (row >= 0)
+                filledPixels[row*u.pixels+i] = winding != 0;
+        }
+    }
+
+    /// Computes the lower envelope of the parabolas centered at the lines' nearest crossings in column i.
+    void computeColumn(std::vector<OutlineSample> &result, int i) const {
+        // The lines whose parabolas form the envelope, and the start of each one's part of it
+        std::vector<int> sites;
+        std::vector<double> boundaries;
+        for (int line = 0; line < lineCount; ++line) {
+            double f = lineSamples[i*lineCount+line].squaredDistance;
+            if (f >= LARGE_VALUE)
+                continue;
+            double p = v.position(linePixel(line));
+            double boundary = -LARGE_VALUE;
+            while (!sites.empty()) {
+                int top = sites.back();
+                double q = v.position(linePixel(top));
+                boundary = ((f+p*p)-(lineSamples[i*lineCount+top].squaredDistance+q*q))/(2*(p-q));
+                if (boundary > boundaries.back())
+                    break;
+                sites.pop_back();
+                boundaries.pop_back();
+                boundary = -LARGE_VALUE;
+            }
+            sites.push_back(line);
+            boundaries.push_back(boundary);
+        }
+        int k = 0;
+        for (int j = 0; j < v.pixels; ++j) {
+            OutlineSample sample;
+            if (!sites.empty()) {
+                double p = v.position(j+.5);
+                while (k+1 < (int) sites.size() && boundaries[k+1] < p)
+                    ++k;
+                const OutlineSample &site = lineSamples[i*lineCount+sites[k]];
+                double q = v.position(linePixel(sites[k]));
+                sample = OutlineSample((p-q)*(p-q)+site.squaredDistance, site.edge);
+            }
+            result[j*u.pixels+i] = sample;
+        }
+    }
+
+};
+
+/// Returns a copy of the edge with its x and y coordinates swapped, or NULL if its type is unknown.
+static EdgeSegment * transposedEdge(const EdgeSegment *edge) {
+    if (const LinearSegment *e = dynamic_cast<const LinearSegment *>(edge))
+        return new LinearSegment(Point2(e->p[0].y, e->p[0].x), Point2(e->p[1].y, e->p[1].x));
+    if (const QuadraticSegment *e = dynamic_cast<const QuadraticSegment *>(edge))
+        return new QuadraticSegment(Point2(e->p[0].y, e->p[0].x), Point2(e->p[1].y, e->p[1].x), Point2(e->p[2].y, e->p[2].x));
+    if (const CubicSegment *e = dynamic_cast<const CubicSegment *>(edge))
+        return new CubicSegment(Point2(e->p[0].y, e->p[0].x), Point2(e->p[1].y, e->p[1].x), Point2(e->p[2].y, e->p[2].x), Point2(e->p[3].y, e->p[3].x));
+    return NULL;
+}
+
+/// Writes the rows of the distance transform's result. The distances of pixels near the outline are corrected to the exact distance
+/// from the edge of their nearest sample and its neighbors in the contour, which is the nearest edge unless they are near the medial axis.
+template <class Output>
+class DistanceTransformRowTask : public ParallelTask {
+
+public:
+    DistanceTransformRowTask(Output &output, const std::vector<const EdgeSegment *> &edges, const std::vector<int> &previousEdges, const std::vector<int> &nextEdges,
+        double range, double maxError, const TransformAxis &x, const TransformAxis &y, const CrossingDistanceTransform &rows,
+        const std::vector<OutlineSample> &rowSamples, const std::vector<OutlineSample> &columnSamples, int outsideSign) :
+        output(output), edges(edges), previousEdges(previousEdges), nextEdges(nextEdges), range(range), maxError(maxError), x(x), y(y),
+        rows(rows), rowSamples(rowSamples), columnSamples(columnSamples), outsideSign(outsideSign) { }
+    void run(int row) {
+        for (int column = 0; column < x.pixels; ++column) {
+            OutlineSample sample = rowSamples[row*x.pixels+column];
+            if (columnSamples[column*y.pixels+row].squaredDistance < sample.squaredDistance)
+                sample = columnSamples[column*y.pixels+row];
+            double distance = sqrt(sample.squaredDistance);
+            // The samples lie on the outline, so the distance can only be too large
+            if (sample.edge >= 0 && distance-maxError <= .5*range) {
+                Point2 p(x.shapeCoordinate(column+.5), y.shapeCoordinate(row+.5));
+                int candidates[3] = { sample.edge, previousEdges[sample.edge], nextEdges[sample.edge] };
+                for (int k = 0; k < 3; ++k) {
                     double param;
-                    SignedDistance distance = (*edge)->signedDistance(p, param);
-                    if (distance < minDistance) {
-                        minDistance = distance;
-                        nearEdge = &*edge;
-                        nearParam = param;
-                    }
+                    distance = min(distance, fabs(edges[candidates[k]]->signedDistance(p, param).distance));
                 }
-            if (nearEdge)
-                (*nearEdge)->distanceToPseudoDistance(minDistance, p, nearParam);
-            output(x, row) = float(minDistance.distance/range+.5);
+            }
+            if (rows.filled(column, row))
+                distance = -distance;
+            output.set(column, row, float(clamp(outsideSign*distance/range+.5, 0., 1.)));
+        }
+    }
+
+private:
+    Output &output;
+    const std::vector<const EdgeSegment *> &edges;
+    const std::vector<int> &previousEdges, &nextEdges;
+    double range, maxError;
+    TransformAxis x, y;
+    const CrossingDistanceTransform &rows;
+    const std::vector<OutlineSample> &rowSamples, &columnSamples;
+    int outsideSign;
+
+};
+
+template <class Output>
+static void generateDistanceTransformSDF(Output &output, int width, int height, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, int supersampling, Executor *executor) {
+    if (width <= 0 || height <= 0)
+        return;
+    supersampling = max(supersampling, 1);
+    TransformAxis x(width, scale.x, translate.x), y(height, scale.y, translate.y);
+    std::vector<const EdgeSegment *> edges, transposedEdges;
+    std::vector<int> previousEdges, nextEdges;
+    std::vector<EdgeHolder> transposed;
+    for (std::vector<Contour>::const_iterator contour = shape.contours.begin(); contour != shape.contours.end(); ++contour) {
+        int start = (int) edges.size(), count = (int) contour->edges.size();
+        for (int i = 0; i < count; ++i) {
+            edges.push_back(contour->edges[i]);
+            previousEdges.push_back(start+(i+count-1)%count);
+            nextEdges.push_back(start+(i+1)%count);
         }
     }
+    transposed.reserve(edges.size());
+    for (std::vector<const EdgeSegment *>::const_iterator edge = edges.begin(); edge != edges.end(); ++edge) {
+        if (EdgeSegment *segment = transposedEdge(*edge)) {
+            transposed.push_back(EdgeHolder(segment));
+            transposedEdges.push_back(transposed.back());
+        } else
+            transposedEdges.push_back(NULL);
+    }
+    // Points farther than range/2 from the output are not needed, the sign is found along the lines through the pixels
+    int xMargin = (int) ceil(.5*range*fabs(scale.x))+1, yMargin = (int) ceil(.5*range*fabs(scale.y))+1;
+    CrossingDistanceTransform rows(edges, x, y, supersampling, yMargin, true);
+    CrossingDistanceTransform columns(transposedEdges, y, x, supersampling, xMargin, false);
+    std::vector<OutlineSample> rowSamples, columnSamples;
+    rows.compute(rowSamples, executor);
+    columns.compute(columnSamples, executor);
+    // Consecutive samples are at most about a diagonal of the lines' grid apart
+    double maxError = 1./(supersampling*min(fabs(scale.x), fabs(scale.y)));
+    DistanceTransformRowTask<Output> task(output, edges, previousEdges, nextEdges, range, maxError, x, y, rows, rowSamples, columnSamples, outsideSign(shape));
+    executeRows(task, height, executor);
+}
+
+void generateDistanceTransformSDF(Bitmap<float> &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, int supersampling, Executor *executor) {
+    BitmapOutput<float> target(output, shape.inverseYAxis);
+    generateDistanceTransformSDF(target, output.width(), output.height(), shape, range, scale, translate, supersampling, executor);
+}
+
+void generateDistanceTransformSDF(const ByteBitmapRef &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, int supersampling, Executor *executor) {
+    ByteOutput target(output, shape.inverseYAxis);
+    generateDistanceTransformSDF(target, output.width, output.height, shape, range, scale, translate, supersampling, executor);
 }
 
 static inline bool pixelClash(const FloatRGB &a, const FloatRGB &b, double threshold) {
@@ -90,77 +981,320 @@ static inline bool pixelClash(const FloatRGB &a, const FloatRGB &b, double thres
         && fabsf(ac-.5f) >= fabsf(bc-.5f); // Out of the pair, only flag the pixel farther from a shape edge
 }
 
-void msdfErrorCorrection(Bitmap<FloatRGB> &output, const Vector2 &threshold) {
-    std::vector<std::pair<int, int> > clashes;
-    int w = output.width(), h = output.height();
-    for (int y = 0; y < h; ++y)
-        for (int x = 0; x < w; ++x) {
-            if ((x > 0 && pixelClash(output(x, y), output(x-1, y), threshold.x))
-                || (x < w-1 && pixelClash(output(x, y), output(x+1, y), threshold.x))
-                || (y > 0 && pixelClash(output(x, y), output(x, y-1), threshold.y))
-                || (y < h-1 && pixelClash(output(x, y), output(x, y+1), threshold.y)))
-                clashes.push_back(std::make_pair(x, y));
+/// Checks pixel x of a row for clashes with its neighbors. The rows above and below are NULL at the edges of the bitmap.
+static bool pixelClashes(const FloatRGB *above, const FloatRGB *row, const FloatRGB *below, int width, int x, const Vector2 &threshold) {
+    return (x > 0 && pixelClash(row[x], row[x-1], threshold.x))
+        || (x < width-1 && pixelClash(row[x], row[x+1], threshold.x))
+        || (above && pixelClash(row[x], above[x], threshold.y))
+        || (below && pixelClash(row[x], below[x], threshold.y));
+}
+
+/// Pixels are checked for clashes in runs of CLASH_RUN pixels of a row, one bit per pixel.
+typedef unsigned long long ClashBits;
+static const int CLASH_RUN = 64;
+
+/// Returns which channels of a pixel are above .5, one bit per channel.
+static inline int channelSides(const FloatRGB &pixel) {
+    return int(pixel.r > .5f)|int(pixel.g > .5f)<<1|int(pixel.b > .5f)<<2;
+}
+
+/// Bit 8*a+b is set if two pixels with channel sides a and b may clash - they are both inside or both outside,
+/// and at least two of their channels are on different sides. This is necessary for pixelClash to return true.
+static const ClashBits CLASHING_SIDES = 0x28480660121400ull;
+
+static inline void rowChannelSides(unsigned char *sides, const FloatRGB *row, int x0, int count) {
+    for (int i = 0; i < count; ++i)
+        sides[i] = (unsigned char) (row ? channelSides(row[x0+i]) : 0);
+}
+
+/// Finds the clashing pixels of the run starting at x0, see pixelClashes.
+/// Pixels are only checked in full if the sides of their channels allow a clash with a neighbor, which rules out all but a few
+/// pixels along the edges. Outside the bitmap, the sides of all channels are taken to be 0, which never clashes.
+static ClashBits detectClashes(const FloatRGB *above, const FloatRGB *row, const FloatRGB *below, int width, int x0, const Vector2 &threshold) {
+    int count = min(CLASH_RUN, width-x0);
+    unsigned char sides[CLASH_RUN+2], sidesAbove[CLASH_RUN], sidesBelow[CLASH_RUN];
+    sides[0] = (unsigned char) (x0 > 0 ? channelSides(row[x0-1]) : 0);
+    sides[count+1] = (unsigned char) (x0+count < width ? channelSides(row[x0+count]) : 0);
+    rowChannelSides(sides+1, row, x0, count);
+    rowChannelSides(sidesAbove, above, x0, count);
+    rowChannelSides(sidesBelow, below, x0, count);
+    ClashBits candidates = 0;
+    for (int i = 0; i < count; ++i) {
+        int pixel = sides[i+1]<<3;
+        ClashBits neighbors = ClashBits(1)<<(pixel|sides[i])|ClashBits(1)<<(pixel|sides[i+2])|ClashBits(1)<<(pixel|sidesAbove[i])|ClashBits(1)<<(pixel|sidesBelow[i]);
+        candidates |= ClashBits((CLASHING_SIDES&neighbors) != 0)<<i;
+    }
+    ClashBits clashes = 0;
+    for (int i = 0; candidates; ++i, candidates >>= 1)
+        if ((candidates&1) && pixelClashes(above, row, below, width, x0+i, threshold))
+            clashes |= ClashBits(1)<<i;
+    return clashes;
+}
+
+static inline void correctPixel(FloatRGB &pixel) {
+    float med = median(pixel.r, pixel.g, pixel.b);
+    pixel.r = med, pixel.g = med, pixel.b = med;
+}
+
+/// Resolves the clashes of a row of a multi-channel distance field and stores it.
+/// Clashes are detected in the uncorrected neighboring rows, like in msdfErrorCorrection.
+static void storeCorrectedRow(ByteOutput &output, const FloatRGB *above, const FloatRGB *row, const FloatRGB *below, const Vector2 &threshold, int y) {
+    int w = output.width();
+    for (int x0 = 0; x0 < w; x0 += CLASH_RUN) {
+        ClashBits clashes = detectClashes(above, row, below, w, x0, threshold);
+        int count = min(CLASH_RUN, w-x0);
+        for (int i = 0; i < count; ++i) {
+            FloatRGB pixel = row[x0+i];
+            if (clashes>>i&1)
+                correctPixel(pixel);
+            output.set(x0+i, y, pixel.r, pixel.g, pixel.b);
         }
-    for (std::vector<std::pair<int, int> >::const_iterator clash = clashes.begin(); clash != clashes.end(); ++clash) {
-        FloatRGB &pixel = output(clash->first, clash->second);
-        float med = median(pixel.r, pixel.g, pixel.b);
-        pixel.r = med, pixel.g = med, pixel.b = med;
     }
 }
 
-void generateMSDF(Bitmap<FloatRGB> &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, double edgeThreshold) {
-    int w = output.width(), h = output.height();
-#ifdef MSDFGEN_USE_OPENMP
-    #pragma omp parallel for
-#endif
-    for (int y = 0; y < h; ++y) {
-        int row = shape.inverseYAxis ? h-y-1 : y;
-        for (int x = 0; x < w; ++x) {
-            Point2 p = Vector2(x+.5, y+.5)/scale-translate;
-
-            struct {
-                SignedDistance minDistance;
-                const EdgeHolder *nearEdge;
-                double nearParam;
-            } r, g, b;
-            r.nearEdge = g.nearEdge = b.nearEdge = NULL;
-            r.nearParam = g.nearParam = b.nearParam = 0;
-
-            for (std::vector<Contour>::const_iterator contour = shape.contours.begin(); contour != shape.contours.end(); ++contour)
-                for (std::vector<EdgeHolder>::const_iterator edge = contour->edges.begin(); edge != contour->edges.end(); ++edge) {
-                    double param;
-                    SignedDistance distance = (*edge)->signedDistance(p, param);
-                    if ((*edge)->color&RED && distance < r.minDistance) {
-                        r.minDistance = distance;
-                        r.nearEdge = &*edge;
-                        r.nearParam = param;
-                    }
-                    if ((*edge)->color&GREEN && distance < g.minDistance) {
-                        g.minDistance = distance;
-                        g.nearEdge = &*edge;
-                        g.nearParam = param;
-                    }
-                    if ((*edge)->color&BLUE && distance < b.minDistance) {
-                        b.minDistance = distance;
-                        b.nearEdge = &*edge;
-                        b.nearParam = param;
-                    }
-                }
+/// Stores the rows of a complete multi-channel distance field with their clashes resolved.
+class StoreCorrectedTask : public ParallelTask {
+
+public:
+    StoreCorrectedTask(ByteOutput &output, const Bitmap<FloatRGB> &field, const Vector2 &threshold) :
+        output(output), field(field), threshold(threshold) { }
+    void run(int y) {
+        int h = field.height();
+        storeCorrectedRow(output, y > 0 ? &field(0, y-1) : NULL, &field(0, y), y < h-1 ? &field(0, y+1) : NULL, threshold, y);
+    }
+
+private:
+    ByteOutput &output;
+    const Bitmap<FloatRGB> &field;
+    Vector2 threshold;
+
+};
+
+/// The clashes of a bitmap, one bit per pixel. Each row starts a new word, so that rows can be marked concurrently.
+/// Up to INLINE_WORDS words, which covers any glyph, no memory is allocated.
+class ClashMask {
+
+public:
+    ClashMask(int width, int height) : rowWords((width+CLASH_RUN-1)/CLASH_RUN) {
+        int words = rowWords*height;
+        if (words > INLINE_WORDS) {
+            heapWords.resize(words);
+            bits = &heapWords[0];
+        } else
+            bits = inlineWords;
+    }
+    ClashBits & operator()(int run, int y) {
+        return bits[y*rowWords+run];
+    }
+
+private:
+    static const int INLINE_WORDS = 1024;
+
+    ClashBits inlineWords[INLINE_WORDS];
+    std::vector<ClashBits> heapWords;
+    ClashBits *bits;
+    int rowWords;
+
+    ClashMask(const ClashMask &);
+    ClashMask & operator=(const ClashMask &);
+
+};
 
-            if (r.nearEdge)
-                (*r.nearEdge)->distanceToPseudoDistance(r.minDistance, p, r.nearParam);
-            if (g.nearEdge)
-                (*g.nearEdge)->distanceToPseudoDistance(g.minDistance, p, g.nearParam);
-            if (b.nearEdge)
-                (*b.nearEdge)->distanceToPseudoDistance(b.minDistance, p, b.nearParam);
-            output(x, row).r = float(r.minDistance.distance/range+.5);
-            output(x, row).g = float(g.minDistance.distance/range+.5);
-            output(x, row).b = float(b.minDistance.distance/range+.5);
+/// Detection and correction of clashes run as two passes over bands of rows, so that bands can be processed concurrently.
+class ErrorCorrectionTask : public ParallelTask {
+
+public:
+    static const int BAND_ROWS = 16;
+
+    ErrorCorrectionTask(Bitmap<FloatRGB> &output, const Vector2 &threshold, ClashMask &clashes) :
+        output(output), threshold(threshold), clashes(clashes), correct(false) { }
+    static int bands(int height) {
+        return (height+BAND_ROWS-1)/BAND_ROWS;
+    }
+    void setCorrect(bool value) {
+        correct = value;
+    }
+    void run(int band) {
+        int w = output.width(), h = output.height();
+        int yEnd = min(h, (band+1)*BAND_ROWS);
+        for (int y = band*BAND_ROWS; y < yEnd; ++y) {
+            if (!correct) {
+                const FloatRGB *above = y > 0 ? &output(0, y-1) : NULL;
+                const FloatRGB *below = y < h-1 ? &output(0, y+1) : NULL;
+                for (int x0 = 0; x0 < w; x0 += CLASH_RUN)
+                    clashes(x0/CLASH_RUN, y) = detectClashes(above, &output(0, y), below, w, x0, threshold);
+                continue;
+            }
+            for (int x0 = 0; x0 < w; x0 += CLASH_RUN) {
+                ClashBits bits = clashes(x0/CLASH_RUN, y);
+                for (int i = 0; bits; ++i, bits >>= 1)
+                    if (bits&1)
+                        correctPixel(output(x0+i, y));
+            }
+        }
+    }
+
+private:
+    Bitmap<FloatRGB> &output;
+    Vector2 threshold;
+    ClashMask &clashes;
+    bool correct;
+
+};
+
+void msdfErrorCorrection(Bitmap<FloatRGB> &output, const Vector2 &threshold, Executor *executor) {
+    if (output.width() == 0)
+        return;
+    ClashMask clashes(output.width(), output.height());
+    ErrorCorrectionTask task(output, threshold, clashes);
+    int bands = ErrorCorrectionTask::bands(output.height());
+    executeRows(task, bands, executor);
+    task.setCorrect(true);
+    executeRows(task, bands, executor);
+}
+
+template <class Output, typename P>
+static void generateMSDFRow(Output &output, const CompiledShapeT<P> &shape, const EdgeIndexT<P> &index, double range, const Vector2 &scale, const Vector2 &translate, const RowSettings &settings, int y) {
+    int w = output.width();
+    SeedEdges<P> seeds;
+    OutsideBand<P> band(shape, index, range, scale, translate, settings, y);
+    for (int x = 0; x < w; x += CompiledShapeT<P>::BATCH_SIZE) {
+        PixelBatch<P> batch(x, y, w, scale, translate);
+        float values[CompiledShapeT<P>::BATCH_SIZE];
+        if (band.contains(x, batch.count, values)) {
+            for (int i = 0; i < batch.count; ++i)
+                output.set(x+i, y, values[i], values[i], values[i]);
+            continue;
+        }
+        const typename EdgeIndexT<P>::Entry * const *begin, * const *end;
+        index.tileEntries(x, y, begin, end);
+        EdgePoint<P> r[CompiledShapeT<P>::BATCH_SIZE], g[CompiledShapeT<P>::BATCH_SIZE], b[CompiledShapeT<P>::BATCH_SIZE];
+        P rBound[CompiledShapeT<P>::BATCH_SIZE], gBound[CompiledShapeT<P>::BATCH_SIZE], bBound[CompiledShapeT<P>::BATCH_SIZE];
+        seeds.evaluate(shape, batch);
+        for (int i = 0; i < batch.count; ++i) {
+            rBound[i] = seeds.bound(i, RED);
+            gBound[i] = seeds.bound(i, GREEN);
+            bBound[i] = seeds.bound(i, BLUE);
+        }
+        for (const typename EdgeIndexT<P>::Entry * const *entry = begin; entry != end; ++entry) {
+            const typename CompiledShapeT<P>::Edge *edge = *entry;
+            EdgeColor color = edge->color;
+            bool skip = true;
+            for (int i = 0; i < batch.count && skip; ++i) {
+                P maxDistance = 0;
+                if (color&RED) maxDistance = max(maxDistance, min(P(fabs(r[i].minDistance.distance)), rBound[i]));
+                if (color&GREEN) maxDistance = max(maxDistance, min(P(fabs(g[i].minDistance.distance)), gBound[i]));
+                if (color&BLUE) maxDistance = max(maxDistance, min(P(fabs(b[i].minDistance.distance)), bBound[i]));
+                skip = index.isFartherThan(**entry, batch.point(i), maxDistance);
+            }
+            if (skip)
+                continue;
+            SignedDistanceT<P> distanceBuffer[CompiledShapeT<P>::BATCH_SIZE];
+            P paramBuffer[CompiledShapeT<P>::BATCH_SIZE];
+            const SignedDistanceT<P> *distance;
+            const P *param;
+            edgeDistances(shape, seeds, edge, batch, distanceBuffer, paramBuffer, distance, param);
+            for (int i = 0; i < batch.count; ++i) {
+                if (color&RED)
+                    r[i].update(distance[i], edge, param[i]);
+                if (color&GREEN)
+                    g[i].update(distance[i], edge, param[i]);
+                if (color&BLUE)
+                    b[i].update(distance[i], edge, param[i]);
+            }
+        }
+        int last = batch.count-1;
+        seeds.clear();
+        if (settings.warmStart) {
+            seeds.add(r[last].nearEdge);
+            seeds.add(g[last].nearEdge);
+            seeds.add(b[last].nearEdge);
+        }
+        // Every edge belongs to at least one channel, so the nearest of the channels' edges is the nearest edge overall.
+        // SignedDistance's comparison breaks ties at corners by the dot product, which picks the edge with the correct sign
+        SignedDistanceT<P> nearest = r[last].minDistance;
+        if (g[last].minDistance < nearest)
+            nearest = g[last].minDistance;
+        if (b[last].minDistance < nearest)
+            nearest = b[last].minDistance;
+        band.setDistance(x+last, nearest.distance);
+        for (int i = 0; i < batch.count; ++i) {
+            Vector2T<P> p = batch.point(i);
+            r[i].applyPseudoDistance(p);
+            g[i].applyPseudoDistance(p);
+            b[i].applyPseudoDistance(p);
+            output.set(x+i, y, float(r[i].minDistance.distance/range+.5), float(g[i].minDistance.distance/range+.5), float(b[i].minDistance.distance/range+.5));
         }
     }
+}
+
+void generateMSDF(Bitmap<FloatRGB> &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, double edgeThreshold, const GeneratorConfig &config) {
+    generateMSDF(output, CompiledShape(shape), range, scale, translate, edgeThreshold, config);
+}
+
+template <typename P>
+void generateMSDF(Bitmap<FloatRGB> &output, const CompiledShapeT<P> &shape, double range, const Vector2 &scale, const Vector2 &translate, double edgeThreshold, const GeneratorConfig &config) {
+    EdgeIndexT<P> index(shape, output.width(), output.height(), scale, translate, true);
+    AdaptiveBlocks blocks(shape, output.width(), output.height(), range, scale, translate, config);
+    BitmapOutput<FloatRGB> target(output, shape.inverseYAxis);
+    GeneratorRowTask<BitmapOutput<FloatRGB>, P, generateMSDFRow<BitmapOutput<FloatRGB>, P> > task(target, shape, index, range, scale, translate, rowSettings(shape, config, blocks));
+    executeRows(task, output.height(), config.executor);
 
     if (edgeThreshold > 0)
-        msdfErrorCorrection(output, edgeThreshold/(scale*range));
+        msdfErrorCorrection(output, edgeThreshold/(scale*range), config.executor);
 }
 
+void generateMSDF(const ByteBitmapRef &output, const Shape &shape, double range, const Vector2 &scale, const Vector2 &translate, double edgeThreshold, const GeneratorConfig &config) {
+    generateMSDF(output, CompiledShape(shape), range, scale, translate, edgeThreshold, config);
+}
+
+template <typename P>
+void generateMSDF(const ByteBitmapRef &output, const CompiledShapeT<P> &shape, double range, const Vector2 &scale, const Vector2 &translate, double edgeThreshold, const GeneratorConfig &config) {
+    int w = output.width, h = output.height;
+    EdgeIndexT<P> index(shape, w, h, scale, translate, true);
+    AdaptiveBlocks blocks(shape, w, h, range, scale, translate, config);
+    ByteOutput target(output, shape.inverseYAxis);
+    if (edgeThreshold <= 0 || w == 0) {
+        GeneratorRowTask<ByteOutput, P, generateMSDFRow<ByteOutput, P> > task(target, shape, index, range, scale, translate, rowSettings(shape, config, blocks));
+        executeRows(task, h, config.executor);
+        return;
+    }
+    Vector2 threshold = edgeThreshold/(scale*range);
+    if (rowsRunConcurrently(config.executor)) {
+        // Rows finish in any order, so the whole field is kept until its clashes have been detected
+        Bitmap<FloatRGB> field(w, h);
+        BitmapOutput<FloatRGB> fieldOutput(field, false);
+        GeneratorRowTask<BitmapOutput<FloatRGB>, P, generateMSDFRow<BitmapOutput<FloatRGB>, P> > task(fieldOutput, shape, index, range, scale, translate, rowSettings(shape, config, blocks));
+        executeRows(task, h, config.executor);
+        StoreCorrectedTask storeTask(target, field, threshold);
+        executeRows(storeTask, h, config.executor);
+        return;
+    }
+    // Each row is stored as soon as the row below it has been generated
+    RowWindow window(w, h);
+    RowSettings settings = rowSettings(shape, config, blocks);
+    for (int y = 0; y <= h; ++y) {
+        if (y < h)
+            generateMSDFRow(window, shape, index, range, scale, translate, settings, y);
+        if (y > 0)
+            storeCorrectedRow(target, window.row(y-2), window.row(y-1), window.row(y), threshold, y-1);
+    }
+}
+
+template void generateSDF(Bitmap<float> &output, const CompiledShape &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config);
+template void generatePseudoSDF(Bitmap<float> &output, const CompiledShape &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config);
+template void generateMSDF(Bitmap<FloatRGB> &output, const CompiledShape &shape, double range, const Vector2 &scale, const Vector2 &translate, double edgeThreshold, const GeneratorConfig &config);
+
+template void generateSDF(Bitmap<float> &output, const CompiledShapef &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config);
+template void generatePseudoSDF(Bitmap<float> &output, const CompiledShapef &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config);
+template void generateMSDF(Bitmap<FloatRGB> &output, const CompiledShapef &shape, double range, const Vector2 &scale, const Vector2 &translate, double edgeThreshold, const GeneratorConfig &config);
+
+template void generateSDF(const ByteBitmapRef &output, const CompiledShape &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config);
+template void generatePseudoSDF(const ByteBitmapRef &output, const CompiledShape &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config);
+template void generateMSDF(const ByteBitmapRef &output, const CompiledShape &shape, double range, const Vector2 &scale, const Vector2 &translate, double edgeThreshold, const GeneratorConfig &config);
+
+template void generateSDF(const ByteBitmapRef &output, const CompiledShapef &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config);
+template void generatePseudoSDF(const ByteBitmapRef &output, const CompiledShapef &shape, double range, const Vector2 &scale, const Vector2 &translate, const GeneratorConfig &config);
+template void generateMSDF(const ByteBitmapRef &output, const CompiledShapef &shape, double range, const Vector2 &scale, const Vector2 &translate, double edgeThreshold, const GeneratorConfig &config);
+
 }
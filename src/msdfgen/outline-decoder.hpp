@@ -0,0 +1,123 @@
+
+#pragma once
+
+// Conversion of glyph outlines in the representation of FreeType and the TrueType glyf table to shapes.
+// Each font loader provides an outline type with the members of FT_Outline that are used here,
+// so that all of them produce identical shapes.
+
+#include "msdfgen/core/Shape.h"
+
+namespace msdfgen {
+
+/// Adds the contours of outline to output. Each point is on the curve or a quadratic or cubic control point as given by bits 0 and 1
+/// of its tag, consecutive quadratic control points imply an on-curve point halfway between them. Coordinates are scaled by glyphScale/64.
+/// Returns false if the outline is malformed.
+template <class Outline>
+bool decodeOutline(Shape &output, const Outline &outline, float glyphScale) {
+    enum PointType {
+        NONE = 0,
+        PATH_POINT,
+        QUADRATIC_POINT,
+        CUBIC_POINT,
+        CUBIC_POINT2
+    };
+    /// The tag of a quadratic control point, without any other flags.
+    const int CONIC_TAG = 0;
+
+    int last = -1;
+    output.contours.reserve(outline.n_contours);
+    // For each contour
+    for (int i = 0; i < outline.n_contours; ++i) {
+
+        Contour &contour = output.addContour();
+        int first = last+1;
+        int firstPathPoint = -1;
+        last = outline.contours[i];
+        // Every edge ends at a different point of the contour
+        contour.edges.reserve(last-first+1);
+
+        PointType state = NONE;
+        Point2 startPoint;
+        Point2 controlPoint[2];
+
+        // For each point on the contour
+        for (int round = 0, index = first; round == 0; ++index) {
+            if (index > last) {
+                if (firstPathPoint < 0)
+                    return false;
+                index = first;
+            }
+            // Close contour
+            if (index == firstPathPoint)
+                ++round;
+
+            Point2 point( glyphScale * outline.points[index].x/64., glyphScale * outline.points[index].y/64.);
+            PointType pointType = outline.tags[index]&1 ? PATH_POINT : outline.tags[index]&2 ? CUBIC_POINT : QUADRATIC_POINT;
+
+            switch (state) {
+                case NONE:
+                    if (pointType == PATH_POINT) {
+                        firstPathPoint = index;
+                        startPoint = point;
+                        state = PATH_POINT;
+                    } else if((outline.tags[first] == CONIC_TAG) && (outline.tags[last] == CONIC_TAG)) {
+                        firstPathPoint = index;
+						Point2 firstPoint( glyphScale * outline.points[first].x/64., glyphScale * outline.points[first].y/64.);
+						Point2 lastPoint( glyphScale * outline.points[last].x/64., glyphScale * outline.points[last].y/64.);
+						startPoint = .5*(firstPoint + lastPoint);
+                        controlPoint[0] = point;						
+                        state = QUADRATIC_POINT;
+					}
+                    break;
+                case PATH_POINT:
+                    if (pointType == PATH_POINT) {
+                        contour.addEdge(new LinearSegment(startPoint, point));
+                        startPoint = point;
+                    } else {
+                        controlPoint[0] = point;
+                        state = pointType;
+                    }
+                    break;
+                case QUADRATIC_POINT:
+                    if (pointType == CUBIC_POINT)
+                        return false;
+                    if (pointType == PATH_POINT) {
+                        contour.addEdge(new QuadraticSegment(startPoint, controlPoint[0], point));
+                        startPoint = point;
+                        state = PATH_POINT;
+                    } else {
+                        Point2 midPoint = .5*controlPoint[0]+.5*point;
+                        contour.addEdge(new QuadraticSegment(startPoint, controlPoint[0], midPoint));
+                        startPoint = midPoint;
+                        controlPoint[0] = point;
+
+                    }
+                    break;
+                case CUBIC_POINT:
+                    if (pointType != CUBIC_POINT)
+                        return false;
+                    controlPoint[1] = point;
+                    state = CUBIC_POINT2;
+                    break;
+                case CUBIC_POINT2:
+                    if (pointType == QUADRATIC_POINT)
+                        return false;
+                    if (pointType == PATH_POINT) {
+                        contour.addEdge(new CubicSegment(startPoint, controlPoint[0], controlPoint[1], point));
+                        startPoint = point;
+                    } else {
+                        Point2 midPoint = .5*controlPoint[1]+.5*point;
+                        contour.addEdge(new CubicSegment(startPoint, controlPoint[0], controlPoint[1], midPoint));
+                        startPoint = midPoint;
+                        controlPoint[0] = point;
+                    }
+                    state = pointType;
+                    break;
+            }
+
+        }
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,328 @@
+
+#include "msdfgen/truetype.h"
+
+#include <cmath>
+#include <vector>
+
+#include "outline-decoder.hpp"
+
+// Composite glyphs nested deeper than this are rejected as malformed.
+#define MAX_COMPONENT_DEPTH 16
+
+namespace msdfgen {
+
+// Simple glyph flags
+#define ON_CURVE_POINT 0x01
+#define X_SHORT_VECTOR 0x02
+#define Y_SHORT_VECTOR 0x04
+#define REPEAT_FLAG 0x08
+#define X_IS_SAME_OR_POSITIVE 0x10
+#define Y_IS_SAME_OR_POSITIVE 0x20
+
+// Composite glyph flags
+#define ARG_1_AND_2_ARE_WORDS 0x0001
+#define ARGS_ARE_XY_VALUES 0x0002
+#define WE_HAVE_A_SCALE 0x0008
+#define MORE_COMPONENTS 0x0020
+#define WE_HAVE_AN_X_AND_Y_SCALE 0x0040
+#define WE_HAVE_A_TWO_BY_TWO 0x0080
+#define USE_MY_METRICS 0x0200
+#define SCALED_COMPONENT_OFFSET 0x0800
+
+/// A glyph outline with the members of FT_Outline read by decodeOutline. Coordinates are in font units.
+struct TrueTypeFont::Outline {
+    struct Vector {
+        long x, y;
+    };
+
+    std::vector<Vector> pointData;
+    std::vector<char> tagData;
+    std::vector<int> contourData;
+
+    int n_contours;
+    const Vector *points;
+    const char *tags;
+    const int *contours;
+};
+
+static unsigned readU16(const unsigned char *p) {
+    return (unsigned) p[0]<<8|p[1];
+}
+
+static int readS16(const unsigned char *p) {
+    return (short) readU16(p);
+}
+
+static unsigned long readU32(const unsigned char *p) {
+    return (unsigned long) p[0]<<24|(unsigned long) p[1]<<16|(unsigned long) p[2]<<8|p[3];
+}
+
+/// Multiplies by a 16.16 fixed-point number, rounding halves away from zero like FreeType's FT_MulFix.
+static long mulFix(long a, long b) {
+    long long ab = (long long) a*b;
+    return (long) ((ab+0x8000-(ab < 0))>>16);
+}
+
+TrueTypeFont::TrueTypeFont(const unsigned char *data, size_t size, int faceIndex) :
+    data(data), size(size), valid(false), glyf(0), glyfLength(0), loca(0), locaLength(0), hmtx(0), hmtxLength(0),
+    glyphCount(0), hMetricCount(0), unitsPerEm(0), longLoca(false) {
+    if (!data || size < 12)
+        return;
+    size_t offset = 0;
+    if (readU32(data) == 0x74746366ul) { // 'ttcf'
+        if (faceIndex < 0 || size < 12+4*(size_t) (faceIndex+1) || (unsigned long) faceIndex >= readU32(data+8))
+            return;
+        offset = readU32(data+12+4*faceIndex);
+    } else if (faceIndex != 0)
+        return;
+    if (offset+12 > size)
+        return;
+    unsigned long version = readU32(data+offset);
+    if (version != 0x00010000ul && version != 0x74727565ul) // 'true'
+        return;
+    size_t tableCount = readU16(data+offset+4);
+    if (offset+12+16*tableCount > size)
+        return;
+    size_t head = 0, maxp = 0, hhea = 0;
+    for (size_t i = 0; i < tableCount; ++i) {
+        const unsigned char *record = data+offset+12+16*i;
+        unsigned long tag = readU32(record);
+        size_t tableOffset = readU32(record+8), tableLength = readU32(record+12);
+        if (tableOffset > size || tableLength > size-tableOffset)
+            return;
+        switch (tag) {
+            case 0x676c7966ul: glyf = tableOffset, glyfLength = tableLength; break; // 'glyf'
+            case 0x6c6f6361ul: loca = tableOffset, locaLength = tableLength; break; // 'loca'
+            case 0x686d7478ul: hmtx = tableOffset, hmtxLength = tableLength; break; // 'hmtx'
+            case 0x68656164ul: head = tableLength >= 54 ? tableOffset : 0; break; // 'head'
+            case 0x6d617870ul: maxp = tableLength >= 6 ? tableOffset : 0; break; // 'maxp'
+            case 0x68686561ul: hhea = tableLength >= 36 ? tableOffset : 0; break; // 'hhea'
+        }
+    }
+    if (!glyf || !loca || !hmtx || !head || !maxp || !hhea)
+        return;
+    unitsPerEm = readU16(data+head+18);
+    longLoca = readS16(data+head+50) != 0;
+    glyphCount = readU16(data+maxp+4);
+    hMetricCount = readU16(data+hhea+34);
+    valid = unitsPerEm > 0 && hMetricCount > 0 && 4*(size_t) hMetricCount <= hmtxLength && (longLoca ? 4 : 2)*((size_t) glyphCount+1) <= locaLength;
+}
+
+bool TrueTypeFont::isValid() const {
+    return valid;
+}
+
+int TrueTypeFont::getGlyphCount() const {
+    return glyphCount;
+}
+
+int TrueTypeFont::getUnitsPerEm() const {
+    return unitsPerEm;
+}
+
+int TrueTypeFont::getAdvance(unsigned int glyphIndex) const {
+    // Glyphs past the last horizontal metric have its advance
+    unsigned int metric = glyphIndex < (unsigned int) hMetricCount ? glyphIndex : hMetricCount-1;
+    return readU16(data+hmtx+4*metric);
+}
+
+bool TrueTypeFont::loadOutline(Outline &outline, unsigned int glyphIndex, int &advance, int depth) const {
+    if (glyphIndex >= (unsigned int) glyphCount || depth > MAX_COMPONENT_DEPTH)
+        return false;
+    advance = getAdvance(glyphIndex);
+    size_t start, end;
+    if (longLoca) {
+        start = readU32(data+loca+4*glyphIndex);
+        end = readU32(data+loca+4*glyphIndex+4);
+    } else {
+        start = 2*(size_t) readU16(data+loca+2*glyphIndex);
+        end = 2*(size_t) readU16(data+loca+2*glyphIndex+2);
+    }
+    // A glyph without data has no contours
+    if (start == end)
+        return true;
+    if (start > end || end > glyfLength || end-start < 10)
+        return false;
+    const unsigned char *p = data+glyf+start, *limit = data+glyf+end;
+    int contourCount = readS16(p);
+    p += 10;
+
+    if (contourCount >= 0) {
+        size_t base = outline.pointData.size();
+        if (p+2*contourCount+2 > limit)
+            return false;
+        // The last points of the contours must increase
+        int pointCount = 0;
+        for (int i = 0; i < contourCount; ++i) {
+            int last = readS16(p+2*i);
+            if (last < pointCount)
+                return false;
+            pointCount = last+1;
+            outline.contourData.push_back((int) base+last);
+        }
+        p += 2*contourCount;
+        p += 2+readU16(p);
+        if (p > limit)
+            return false;
+
+        std::vector<unsigned char> flags(pointCount);
+        for (int i = 0; i < pointCount;) {
+            if (p >= limit)
+                return false;
+            unsigned char flag = *p++;
+            int repeat = 1;
+            if (flag&REPEAT_FLAG) {
+                if (p >= limit)
+                    return false;
+                repeat += *p++;
+            }
+            for (; repeat > 0 && i < pointCount; --repeat)
+                flags[i++] = flag;
+        }
+        outline.pointData.resize(base+pointCount);
+        outline.tagData.resize(base+pointCount);
+        long x = 0, y = 0;
+        for (int i = 0; i < pointCount; ++i) {
+            unsigned char flag = flags[i];
+            if (flag&X_SHORT_VECTOR) {
+                if (p+1 > limit)
+                    return false;
+                x += flag&X_IS_SAME_OR_POSITIVE ? *p : -(long) *p;
+                ++p;
+            } else if (!(flag&X_IS_SAME_OR_POSITIVE)) {
+                if (p+2 > limit)
+                    return false;
+                x += readS16(p);
+                p += 2;
+            }
+            outline.pointData[base+i].x = x;
+            outline.tagData[base+i] = flag&ON_CURVE_POINT;
+        }
+        for (int i = 0; i < pointCount; ++i) {
+            unsigned char flag = flags[i];
+            if (flag&Y_SHORT_VECTOR) {
+                if (p+1 > limit)
+                    return false;
+                y += flag&Y_IS_SAME_OR_POSITIVE ? *p : -(long) *p;
+                ++p;
+            } else if (!(flag&Y_IS_SAME_OR_POSITIVE)) {
+                if (p+2 > limit)
+                    return false;
+                y += readS16(p);
+                p += 2;
+            }
+            outline.pointData[base+i].y = y;
+        }
+        return true;
+    }
+
+    // Composite glyph, its components are loaded one after another and transformed in place
+    size_t firstPoint = outline.pointData.size();
+    unsigned flags;
+    do {
+        if (p+4 > limit)
+            return false;
+        flags = readU16(p);
+        unsigned int componentIndex = readU16(p+2);
+        p += 4;
+        int arg1, arg2;
+        if (flags&ARG_1_AND_2_ARE_WORDS) {
+            if (p+4 > limit)
+                return false;
+            arg1 = flags&ARGS_ARE_XY_VALUES ? readS16(p) : (int) readU16(p);
+            arg2 = flags&ARGS_ARE_XY_VALUES ? readS16(p+2) : (int) readU16(p+2);
+            p += 4;
+        } else {
+            if (p+2 > limit)
+                return false;
+            arg1 = flags&ARGS_ARE_XY_VALUES ? (signed char) p[0] : (int) p[0];
+            arg2 = flags&ARGS_ARE_XY_VALUES ? (signed char) p[1] : (int) p[1];
+            p += 2;
+        }
+        // The transformation in 16.16 fixed point, read in the same order as FreeType
+        long xx = 0x10000, yx = 0, xy = 0, yy = 0x10000;
+        bool transformed = true;
+        if (flags&WE_HAVE_A_SCALE) {
+            if (p+2 > limit)
+                return false;
+            xx = yy = 4l*readS16(p);
+            p += 2;
+        } else if (flags&WE_HAVE_AN_X_AND_Y_SCALE) {
+            if (p+4 > limit)
+                return false;
+            xx = 4l*readS16(p);
+            yy = 4l*readS16(p+2);
+            p += 4;
+        } else if (flags&WE_HAVE_A_TWO_BY_TWO) {
+            if (p+8 > limit)
+                return false;
+            xx = 4l*readS16(p);
+            yx = 4l*readS16(p+2);
+            xy = 4l*readS16(p+4);
+            yy = 4l*readS16(p+6);
+            p += 8;
+        } else
+            transformed = false;
+
+        size_t componentStart = outline.pointData.size();
+        int componentAdvance;
+        if (!loadOutline(outline, componentIndex, componentAdvance, depth+1))
+            return false;
+        if (flags&USE_MY_METRICS)
+            advance = componentAdvance;
+        size_t componentEnd = outline.pointData.size();
+
+        if (transformed) {
+            for (size_t i = componentStart; i < componentEnd; ++i) {
+                Outline::Vector &point = outline.pointData[i];
+                long x = mulFix(point.x, xx)+mulFix(point.y, xy);
+                long y = mulFix(point.x, yx)+mulFix(point.y, yy);
+                point.x = x, point.y = y;
+            }
+        }
+        long dx, dy;
+        if (flags&ARGS_ARE_XY_VALUES) {
+            dx = arg1, dy = arg2;
+            if (transformed && (flags&SCALED_COMPONENT_OFFSET)) {
+                dx = mulFix(dx, (long) floor(sqrt((double) xx*xx+(double) xy*xy)+.5));
+                dy = mulFix(dy, (long) floor(sqrt((double) yy*yy+(double) yx*yx)+.5));
+            }
+        } else {
+            // Point matching: the arg1-th point of the glyph so far meets the arg2-th point of the component
+            size_t k = firstPoint+arg1, l = componentStart+arg2;
+            if (k >= componentStart || l >= componentEnd)
+                return false;
+            dx = outline.pointData[k].x-outline.pointData[l].x;
+            dy = outline.pointData[k].y-outline.pointData[l].y;
+        }
+        if (dx || dy) {
+            for (size_t i = componentStart; i < componentEnd; ++i) {
+                outline.pointData[i].x += dx;
+                outline.pointData[i].y += dy;
+            }
+        }
+    } while (flags&MORE_COMPONENTS);
+    return true;
+}
+
+bool TrueTypeFont::loadGlyph(Shape &output, unsigned int glyphIndex, double *advance) const {
+    if (!valid)
+        return false;
+    Outline outline;
+    int advanceWidth;
+    if (!loadOutline(outline, glyphIndex, advanceWidth, 0))
+        return false;
+    outline.n_contours = (int) outline.contourData.size();
+    outline.points = outline.pointData.empty() ? NULL : &outline.pointData[0];
+    outline.tags = outline.tagData.empty() ? NULL : &outline.tagData[0];
+    outline.contours = outline.contourData.empty() ? NULL : &outline.contourData[0];
+
+    output.contours.clear();
+    output.inverseYAxis = false;
+    if (advance)
+        *advance = advanceWidth/64.;
+    float glyphScale = 2048.0f/unitsPerEm;
+    return decodeOutline(output, outline, glyphScale);
+}
+
+}